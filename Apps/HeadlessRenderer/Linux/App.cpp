@@ -0,0 +1,226 @@
+// Renders a JavaScript scene offscreen and writes frames to PNG files, without a window or display.
+//
+// Usage: HeadlessRenderer [--width <pixels>] [--height <pixels>] [--warmup <frames>] [--frames <count>] [--output <prefix>] <script>...
+//
+// The scripts are loaded after Babylon.js and are expected to create a scene and render it from requestAnimationFrame, for
+// example through engine.runRenderLoop. The first frames are rendered without being captured so that the scene can load,
+// then each captured frame is written to <prefix><index>.png. Without a GPU, run it on Mesa's software rasterizer with
+// LIBGL_ALWAYS_SOFTWARE=1 EGL_PLATFORM=surfaceless.
+
+#include <Babylon/AppRuntime.h>
+#include <Babylon/Graphics/Device.h>
+#include <Babylon/ScriptLoader.h>
+#include <Babylon/Plugins/NativeEngine.h>
+#include <Babylon/Polyfills/Console.h>
+#include <Babylon/Polyfills/Window.h>
+#include <Babylon/Polyfills/XMLHttpRequest.h>
+#include <Babylon/Polyfills/Canvas.h>
+
+#include <bimg/bimg.h>
+#include <bx/file.h>
+
+#include <unistd.h> // readlink
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <future>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct Options
+    {
+        size_t Width{640};
+        size_t Height{480};
+        uint32_t WarmupFrames{60};
+        uint32_t Frames{1};
+        std::string Output{"frame"};
+        std::vector<std::string> Scripts{};
+    };
+
+    std::filesystem::path GetModulePath()
+    {
+        char exe[1024];
+
+        int ret = readlink("/proc/self/exe", exe, sizeof(exe) - 1);
+        if (ret == -1)
+        {
+            exit(1);
+        }
+        exe[ret] = 0;
+        return std::filesystem::path{exe};
+    }
+
+    std::string GetUrlFromPath(const std::filesystem::path path)
+    {
+        return std::string("file://") + path.generic_string();
+    }
+
+    bool ParseOptions(int argc, const char* const* argv, Options& options)
+    {
+        for (int index = 1; index < argc; ++index)
+        {
+            const std::string argument{argv[index]};
+            const bool hasValue{index + 1 < argc};
+            if (argument == "--width" && hasValue)
+            {
+                options.Width = std::stoul(argv[++index]);
+            }
+            else if (argument == "--height" && hasValue)
+            {
+                options.Height = std::stoul(argv[++index]);
+            }
+            else if (argument == "--warmup" && hasValue)
+            {
+                options.WarmupFrames = static_cast<uint32_t>(std::stoul(argv[++index]));
+            }
+            else if (argument == "--frames" && hasValue)
+            {
+                options.Frames = static_cast<uint32_t>(std::stoul(argv[++index]));
+            }
+            else if (argument == "--output" && hasValue)
+            {
+                options.Output = argv[++index];
+            }
+            else if (argument.rfind("--", 0) == 0)
+            {
+                return false;
+            }
+            else
+            {
+                options.Scripts.push_back(std::filesystem::absolute(argument).generic_string());
+            }
+        }
+
+        return !options.Scripts.empty() && options.Width != 0 && options.Height != 0;
+    }
+
+    bool WritePng(const std::string& path, const Babylon::Graphics::ReadBackImage& image)
+    {
+        bx::FileWriter writer{};
+        bx::Error error{};
+        if (!bx::open(&writer, path.c_str(), false, &error))
+        {
+            return false;
+        }
+
+        bimg::imageWritePng(&writer, image.Width, image.Height, image.Width * 4, image.Pixels.data(), bimg::TextureFormat::RGBA8, false, &error);
+        bx::close(&writer);
+        return error.isOk();
+    }
+}
+
+int main(int argc, const char* const* argv)
+{
+    Options options{};
+    try
+    {
+        if (!ParseOptions(argc, argv, options))
+        {
+            std::cerr << "Usage: " << argv[0] << " [--width <pixels>] [--height <pixels>] [--warmup <frames>] [--frames <count>] [--output <prefix>] <script>..." << std::endl;
+            return 1;
+        }
+    }
+    catch (const std::exception&)
+    {
+        std::cerr << "Invalid option value." << std::endl;
+        return 1;
+    }
+
+    Babylon::Graphics::Configuration graphicsConfig{};
+    graphicsConfig.Offscreen = true;
+    graphicsConfig.Width = options.Width;
+    graphicsConfig.Height = options.Height;
+
+    // Frames are rendered on demand, as fast as possible.
+    graphicsConfig.FramePacing.VSync = false;
+
+    Babylon::Graphics::Device device{graphicsConfig};
+    Babylon::Graphics::DeviceUpdate update{device.GetUpdate("update")};
+
+    // Rendering must be started for the engine to be initialized while the scripts load.
+    device.StartRenderingCurrentFrame();
+    update.Start();
+
+    std::optional<Babylon::Polyfills::Canvas> nativeCanvas{};
+    std::atomic<int> exitCode{0};
+
+    {
+        Babylon::AppRuntime::Options runtimeOptions{};
+        runtimeOptions.UnhandledExceptionHandler = [&exitCode](const Napi::Error& error) {
+            std::cerr << "[Uncaught Error] " << error.Get("stack").As<Napi::String>().Utf8Value() << std::endl;
+            exitCode = 1;
+        };
+
+        Babylon::AppRuntime runtime{runtimeOptions};
+
+        runtime.Dispatch([&device, &nativeCanvas](Napi::Env env) {
+            Babylon::Polyfills::Console::Initialize(env, [](const char* message, auto) {
+                std::cout << message;
+                std::cout.flush();
+            });
+
+            Babylon::Polyfills::Window::Initialize(env);
+            Babylon::Polyfills::XMLHttpRequest::Initialize(env);
+            nativeCanvas.emplace(Babylon::Polyfills::Canvas::Initialize(env));
+
+            device.AddToJavaScript(env);
+            Babylon::Plugins::NativeEngine::Initialize(env);
+        });
+
+        const std::string moduleRootUrl{GetUrlFromPath(GetModulePath().parent_path())};
+
+        Babylon::ScriptLoader loader{runtime};
+        loader.LoadScript(moduleRootUrl + "/Scripts/babylon.max.js");
+        loader.LoadScript(moduleRootUrl + "/Scripts/babylonjs.loaders.js");
+        loader.LoadScript(moduleRootUrl + "/Scripts/babylonjs.materials.js");
+        for (const auto& script : options.Scripts)
+        {
+            loader.LoadScript(GetUrlFromPath(script));
+        }
+
+        std::promise<void> loaded{};
+        loader.Dispatch([&loaded](Napi::Env) { loaded.set_value(); });
+        loaded.get_future().wait();
+
+        update.Finish();
+        device.FinishRenderingCurrentFrame();
+
+        for (uint32_t frame = 0; frame < options.WarmupFrames && exitCode == 0; ++frame)
+        {
+            device.RenderFrame(update);
+        }
+
+        for (uint32_t frame = 0; frame < options.Frames && exitCode == 0; ++frame)
+        {
+            auto readBack{device.ReadBackAsync()};
+            do
+            {
+                device.RenderFrame(update);
+            } while (readBack.wait_for(std::chrono::seconds{0}) != std::future_status::ready);
+
+            try
+            {
+                const std::string path{options.Output + std::to_string(frame) + ".png"};
+                if (!WritePng(path, readBack.get()))
+                {
+                    std::cerr << "Failed to write " << path << std::endl;
+                    exitCode = 1;
+                }
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "Read back failed: " << e.what() << std::endl;
+                exitCode = 1;
+            }
+        }
+
+        nativeCanvas.reset();
+    }
+
+    return exitCode;
+}
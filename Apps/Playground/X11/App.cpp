@@ -3,6 +3,9 @@
 #include <X11/keysymdef.h>
 #include <X11/Xlib.h> // will include X11 which #defines None... Don't mess with order of includes.
 #include <X11/Xutil.h>
+#ifdef BABYLON_NATIVE_XRANDR
+#include <X11/extensions/Xrandr.h>
+#endif
 #include <unistd.h> // syscall
 #undef None
 #include <filesystem>
@@ -191,6 +194,20 @@ int main(int _argc, const char* const* _argv)
     XSetClassHint(display, window, hint);
     XFree(hint);
 
+    // Screen configuration changes can change the pixel ratio.
+    int randrEventBase{-1};
+#ifdef BABYLON_NATIVE_XRANDR
+    int randrErrorBase{};
+    if (XRRQueryExtension(display, &randrEventBase, &randrErrorBase))
+    {
+        XRRSelectInput(display, root, RRScreenChangeNotifyMask);
+    }
+    else
+    {
+        randrEventBase = -1;
+    }
+#endif
+
     XIM im = XOpenIM(display, NULL, NULL, NULL);
 
     XIC ic = XCreateIC(im
@@ -221,6 +238,18 @@ int main(int _argc, const char* const* _argv)
             XEvent event;
             XNextEvent(display, &event);
 
+#ifdef BABYLON_NATIVE_XRANDR
+            if (randrEventBase >= 0 && event.type == randrEventBase + RRScreenChangeNotify)
+            {
+                XRRUpdateConfiguration(&event);
+                if (device)
+                {
+                    device->UpdateDisplayMetrics();
+                }
+                continue;
+            }
+#endif
+
             switch (event.type)
             {
                 case Expose:
@@ -236,6 +265,12 @@ int main(int _argc, const char* const* _argv)
                     {
                         const XConfigureEvent& xev = event.xconfigure;
                         UpdateWindowSize(xev.width, xev.height);
+
+                        // Without XRandR, screen changes can only be noticed when the window is reconfigured.
+                        if (randrEventBase < 0 && device)
+                        {
+                            device->UpdateDisplayMetrics();
+                        }
                     }
                     break;
                 case ButtonPress:
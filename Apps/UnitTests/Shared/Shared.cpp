@@ -7,11 +7,15 @@
 #include <Babylon/Polyfills/Canvas.h>
 #include <Babylon/Plugins/NativeEngine.h>
 #include <Babylon/ScriptLoader.h>
+#include <Babylon/Graphics/continuation_scheduler.h>
+#include <arcana/threading/dispatcher.h>
+#include <atomic>
 #include <chrono>
 #include <thread>
 #include <optional>
 #include <future>
 #include <iostream>
+#include <vector>
 
 namespace
 {
@@ -212,6 +216,77 @@ TEST(Performance, Spheres)
     std::cout.flush();
 }
 
+namespace
+{
+    // Posts work from several producer threads while the consumer ticks, like per-frame work posted to the render schedulers.
+    // Each item checks that it runs right after the previous item of its producer.
+    template<typename PostT, typename TickT>
+    std::chrono::milliseconds MeasureContention(PostT post, TickT tick)
+    {
+        constexpr uint32_t producerCount{4};
+        constexpr uint32_t itemsPerProducer{250000};
+        constexpr auto timeout{std::chrono::seconds{60}};
+
+        // Only touched by the consumer thread, from within the posted work.
+        std::vector<uint32_t> nextItems(producerCount, 0);
+        uint32_t completed{0};
+        uint32_t outOfOrder{0};
+
+        const auto start = std::chrono::high_resolution_clock::now();
+
+        std::vector<std::thread> producers{};
+        for (uint32_t producer = 0; producer < producerCount; producer++)
+        {
+            producers.emplace_back([&post, &nextItems, &completed, &outOfOrder, producer]() {
+                for (uint32_t item = 0; item < itemsPerProducer; item++)
+                {
+                    post([&nextItems, &completed, &outOfOrder, producer, item]() {
+                        if (nextItems[producer] != item)
+                        {
+                            outOfOrder++;
+                        }
+                        nextItems[producer] = item + 1;
+                        completed++;
+                    });
+                }
+            });
+        }
+
+        while (completed < producerCount * itemsPerProducer && std::chrono::high_resolution_clock::now() - start < timeout)
+        {
+            tick();
+        }
+
+        for (auto& producer : producers)
+        {
+            producer.join();
+        }
+
+        const auto stop = std::chrono::high_resolution_clock::now();
+        EXPECT_EQ(completed, producerCount * itemsPerProducer);
+        EXPECT_EQ(outOfOrder, 0u);
+        return std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
+    }
+}
+
+TEST(Performance, ContinuationDispatcherContention)
+{
+    arcana::cancellation_source cancellation{};
+
+    Babylon::continuation_dispatcher<> lockFreeDispatcher{};
+    const auto lockFreeDuration = MeasureContention(
+        [&](auto work) { lockFreeDispatcher.scheduler()(std::move(work)); },
+        [&]() { lockFreeDispatcher.tick(cancellation); });
+
+    arcana::manual_dispatcher<128> lockingDispatcher{};
+    const auto lockingDuration = MeasureContention(
+        [&](auto work) { lockingDispatcher.queue(std::move(work)); },
+        [&]() { lockingDispatcher.tick(cancellation); });
+
+    std::cout << "continuation_dispatcher: " << lockFreeDuration.count() << " ms, arcana::manual_dispatcher: " << lockingDuration.count() << " ms" << std::endl;
+    std::cout.flush();
+}
+
 int RunTests(const Babylon::Graphics::Configuration& config)
 {
     deviceConfig = config;
@@ -6,9 +6,32 @@
 
 #include <future>
 #include <memory>
+#include <vector>
 
 namespace Babylon::Graphics
 {
+    struct DynamicResolutionConfiguration
+    {
+        // Target render time of a frame in milliseconds. 0 disables dynamic resolution.
+        float TargetFrameTime{};
+
+        // Bounds of the render scale, relative to the resolution set by the hardware scaling level.
+        float MinScale{0.5f};
+        float MaxScale{1.0f};
+    };
+
+    struct FramePacingConfiguration
+    {
+        // Wait for vertical sync when presenting.
+        bool VSync{true};
+
+        // Frame rate to cap rendering at. 0 leaves pacing to vsync, or runs uncapped without it.
+        float TargetFrameRate{};
+
+        // Delays the start of each frame until just enough time is left to render it before the next deadline.
+        bool LateLatch{};
+    };
+
     struct Configuration
     {
         // Custom device to use instead of creating one internally.
@@ -17,6 +40,10 @@ namespace Babylon::Graphics
         // The platform specific window.
         WindowT Window{};
 
+        // Renders into an internal framebuffer of the given size instead of the window, which can be read back with
+        // Device::ReadBackAsync. Combined with Device::RenderFrame this renders on demand without a window.
+        bool Offscreen{};
+
         // The resolution width.
         size_t Width{};
 
@@ -28,6 +55,34 @@ namespace Babylon::Graphics
 
         // When enabled, back buffer will be premultiplied with alpha value.
         bool AlphaPremultiplied{};
+
+        // Texture memory budget in bytes. Cold textures are evicted when this is exceeded. 0 disables the budget.
+        size_t TextureMemoryBudget{};
+
+        // When enabled, bgfx submits frames on its own render thread so the next frame is recorded while the previous one is rendered.
+        // Plugins that bind native textures on the render thread (ExternalTexture, NativeCamera, NativeXr) are not supported then.
+        bool MultithreadedRendering{};
+
+        // Maximum number of frames the graphics driver may queue up.
+        uint8_t MaxFrameLatency{1};
+
+        // Relative size change a window resize may make before the back buffer is reset. Smaller changes keep the current back
+        // buffer until the size has settled, with the frames rendered at the new size and scaled to fill it. 0 resets on every resize.
+        float BackBufferResizeThreshold{};
+
+        // Adjusts the render scale to meet a target frame time.
+        DynamicResolutionConfiguration DynamicResolution{};
+
+        FramePacingConfiguration FramePacing{};
+    };
+
+    struct ReadBackImage
+    {
+        uint32_t Width{};
+        uint32_t Height{};
+
+        // Tightly packed RGBA8 pixels, top row first.
+        std::vector<uint8_t> Pixels{};
     };
 
     class Device;
@@ -89,6 +144,12 @@ namespace Babylon::Graphics
         void UpdateMSAA(uint8_t value);
         void UpdateAlphaPremultiplied(bool enabled);
 
+        // Re-queries display metrics such as the device pixel ratio, which are otherwise cached where querying is expensive.
+        // Call this when the window moves to another screen or the screen configuration changes, such as on an XRandR
+        // screen change notification, rather than on every window configuration change.
+        void UpdateDisplayMetrics();
+        void SetDevicePixelRatioChangedCallback(std::function<void(float)> callback);
+
         void AddToJavaScript(Napi::Env);
 
         Napi::Value CreateContext(Napi::Env);
@@ -101,6 +162,14 @@ namespace Babylon::Graphics
         void StartRenderingCurrentFrame();
         void FinishRenderingCurrentFrame();
 
+        // Renders exactly one frame, opening the update for the frame to be recorded. Must not be called while a frame is
+        // being rendered.
+        void RenderFrame(DeviceUpdate& update);
+
+        // Reads back the color target of an offscreen device after the frame being recorded has rendered. Read backs
+        // requested in the same frame share one copy. The result is ready after the next frame or two have rendered.
+        std::future<ReadBackImage> ReadBackAsync();
+
         void SetDiagnosticOutput(std::function<void(const char* output)> outputFunction);
 
         float GetHardwareScalingLevel();
@@ -108,6 +177,11 @@ namespace Babylon::Graphics
 
         float GetDevicePixelRatio() const;
 
+        void SetDynamicResolution(const DynamicResolutionConfiguration& config);
+        float GetRenderScale() const;
+
+        void SetFramePacing(const FramePacingConfiguration& config);
+
         PlatformInfo GetPlatformInfo() const;
 
     private:
@@ -2,6 +2,7 @@
 
 #include <queue>
 #include <functional>
+#include <mutex>
 
 #include <bgfx/bgfx.h>
 #include <bgfx/platform.h>
@@ -46,6 +47,8 @@ namespace Babylon::Graphics
     private:
         std::function<void(const char* output)> m_outputFunction;
 
+        // Screen shots are requested on the API thread and delivered on the bgfx render thread.
+        std::mutex m_screenShotCallbacksMutex{};
         std::queue<std::function<void(std::vector<uint8_t>)>> m_screenShotCallbacks;
 
         CaptureData m_captureData{};
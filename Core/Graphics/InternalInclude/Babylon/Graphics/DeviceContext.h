@@ -18,6 +18,8 @@ namespace Babylon::Graphics
     class Update;
     class DeviceContext;
     class DeviceImpl;
+    class Texture;
+    struct DynamicResolutionConfiguration;
 
     struct TextureInfo final
     {
@@ -29,6 +31,51 @@ namespace Babylon::Graphics
         bgfx::TextureFormat::Enum Format{};
     };
 
+    struct TextureMemoryStats final
+    {
+        // Bytes of texture memory currently allocated.
+        size_t Usage{};
+
+        // Bytes of texture memory allowed before evicting cold textures. 0 means unlimited.
+        size_t Budget{};
+
+        // Number of textures evicted since the device context was created.
+        size_t EvictionCount{};
+    };
+
+    struct FrameStats final
+    {
+        // Bytes uploaded to textures through sub-region updates.
+        uint64_t TextureBytesUploaded{};
+
+        // Bytes that would have been uploaded on top of TextureBytesUploaded had the whole mip been updated.
+        uint64_t TextureBytesSaved{};
+
+        // Views used by the frame and the view acquisitions that didn't fit in the view range of the device.
+        uint32_t ViewsUsed{};
+        uint32_t ViewsOverflowed{};
+
+        // Time between the starts of the last two frames and the smoothed deviation from the expected frame time, in milliseconds.
+        float FrameTime{};
+        float FrameTimeJitter{};
+
+        // Draw calls submitted by canvases, and how many they would have been without batching.
+        uint32_t CanvasDrawCalls{};
+        uint32_t CanvasUnbatchedDrawCalls{};
+
+        // Vertices drawn by canvases, and canvas flushes that didn't fit in the bgfx transient buffers of the frame.
+        uint32_t CanvasVertices{};
+        uint32_t CanvasTransientOverflows{};
+    };
+
+    struct CanvasStats final
+    {
+        uint32_t DrawCalls{};
+        uint32_t UnbatchedDrawCalls{};
+        uint32_t Vertices{};
+        uint32_t TransientOverflows{};
+    };
+
     class UpdateToken final
     {
     public:
@@ -103,6 +150,11 @@ namespace Babylon::Graphics
         float GetHardwareScalingLevel();
         void SetHardwareScalingLevel(float level);
 
+        // Scale applied by dynamic resolution on top of the hardware scaling level, and the combination of both.
+        float GetRenderScale() const;
+        float GetRenderScalingLevel() const;
+        void SetDynamicResolution(const DynamicResolutionConfiguration& config);
+
         size_t GetWidth() const;
         size_t GetHeight() const;
         float GetDevicePixelRatio();
@@ -113,21 +165,62 @@ namespace Babylon::Graphics
         using CaptureCallbackTicketT = arcana::ticketed_collection<std::function<void(const BgfxCallback::CaptureData&)>>::ticket;
         CaptureCallbackTicketT AddCaptureCallback(std::function<void(const BgfxCallback::CaptureData&)> callback);
 
+        // Never fails. Once the bgfx view limit is reached, the last view available to rendering is returned again.
         bgfx::ViewId AcquireNewViewId(bgfx::Encoder&);
 
+        // The last bgfx view is reserved for blits and read backs that run after all rendering. It is never acquired.
+        static bgfx::ViewId GetBlitViewId();
+
+        // Whether the view is the most recently acquired one, so drawing into it can't reorder draws of other views.
+        bool IsLastViewId(bgfx::ViewId viewId) const;
+
+        // The framebuffer that default back buffer views render into, which is the invalid handle unless the device is offscreen.
+        bgfx::FrameBufferHandle GetBackBufferHandle() const;
+
         // TODO: find a different way to get the texture info for frame capture
         void AddTexture(bgfx::TextureHandle handle, uint16_t width, uint16_t height, bool hasMips, uint16_t numLayers, bgfx::TextureFormat::Enum format);
         void RemoveTexture(bgfx::TextureHandle handle);
         TextureInfo GetTextureInfo(bgfx::TextureHandle handle);
         static bx::AllocatorI& GetDefaultAllocator() { return m_allocator; }
 
+        // Texture memory accounting for textures created through Graphics::Texture.
+        void AddTexture(Texture& texture);
+        void RemoveTexture(Texture& texture);
+        size_t GetTextureMemoryBudget() const;
+        void SetTextureMemoryBudget(size_t bytes);
+        TextureMemoryStats GetTextureMemoryStats() const;
+
+        // Evicts least recently used textures until usage is back under budget. Must be called from the JavaScript thread.
+        void EnforceTextureMemoryBudget();
+
+        uint32_t GetFrameNumber() const;
+
+        // Whether frames are rendered on a bgfx render thread, one frame behind the frame being recorded.
+        bool IsMultithreaded() const;
+
+        // Stats of the last rendered frame.
+        FrameStats GetFrameStats() const;
+        void AddTextureUploadStats(uint64_t uploadedBytes, uint64_t savedBytes);
+        void AddCanvasStats(const CanvasStats& stats);
+
     private:
         friend UpdateToken;
 
+        struct TextureRecord
+        {
+            TextureInfo Info{};
+            size_t Bytes{};
+            Texture* Owner{};
+        };
+
+        void AddTextureRecord(bgfx::TextureHandle handle, TextureRecord record);
+
         DeviceImpl& m_graphicsImpl;
 
-        std::unordered_map<uint16_t, TextureInfo> m_textureHandleToInfo{};
-        std::mutex m_textureHandleToInfoMutex{};
+        std::unordered_map<uint16_t, TextureRecord> m_textureHandleToInfo{};
+        mutable std::mutex m_textureHandleToInfoMutex{};
+        size_t m_textureMemoryUsage{};
+        size_t m_textureEvictionCount{};
 
         static inline bx::DefaultAllocator m_allocator{};
     };
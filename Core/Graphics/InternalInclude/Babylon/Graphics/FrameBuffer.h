@@ -2,6 +2,7 @@
 
 #include <bgfx/bgfx.h>
 #include <optional>
+#include <vector>
 
 namespace Babylon::Graphics
 {
@@ -28,6 +29,10 @@ namespace Babylon::Graphics
 
         void Dispose();
 
+        // Counts an attachment that only exists within this frame buffer against the texture memory of the device
+        // context, until the frame buffer is disposed.
+        void TrackAttachment(bgfx::TextureHandle handle, uint16_t width, uint16_t height, bgfx::TextureFormat::Enum format);
+
         bgfx::FrameBufferHandle Handle() const;
         uint16_t Width() const;
         uint16_t Height() const;
@@ -48,12 +53,15 @@ namespace Babylon::Graphics
 
     private:
         Rect GetBgfxScissor(float x, float y, float width, float height) const;
-        void SetBgfxViewPortAndScissor(bgfx::Encoder& encoder, const Rect& viewPort, const Rect& scissor);
+        bool IsViewCurrent() const;
+        void AcquireViewId(bgfx::Encoder& encoder);
+        void SetBgfxViewPort(bgfx::Encoder& encoder, const Rect& viewPort);
 
         DeviceContext& m_deviceContext;
         const uintptr_t m_deviceID{};
 
         bgfx::FrameBufferHandle m_handle{};
+        std::vector<bgfx::TextureHandle> m_trackedAttachments{};
         const uint16_t m_width{};
         const uint16_t m_height{};
         const bool m_defaultBackBuffer{};
@@ -61,11 +69,14 @@ namespace Babylon::Graphics
         const bool m_hasStencil{};
 
         std::optional<bgfx::ViewId> m_viewId{};
+        uint32_t m_viewFrameNumber{};
+
+        // Whether anything was cleared, drawn or blitted in the current view.
+        bool m_viewUsed{};
 
         Rect m_bgfxViewPort{0.0f, 0.0f, 1.0f, 1.0f};
         Rect m_desiredViewPort{0.0f, 0.0f, 1.0f, 1.0f};
 
-        Rect m_bgfxScissor{};
         Rect m_desiredScissor{};
 
         bool m_disposed{};
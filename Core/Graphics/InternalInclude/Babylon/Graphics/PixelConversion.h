@@ -0,0 +1,10 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Babylon::Graphics
+{
+    // Copies an image of 32-bit pixels between buffers with different row pitches, optionally swapping the red and blue
+    // channels (BGRA <-> RGBA) and flipping it vertically, in a single pass.
+    void CopyPixels32(const uint8_t* source, uint32_t sourcePitch, uint8_t* destination, uint32_t destinationPitch, uint32_t width, uint32_t height, bool swapRedBlue, bool flipY);
+}
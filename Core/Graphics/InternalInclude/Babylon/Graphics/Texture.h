@@ -2,6 +2,10 @@
 
 #include <bgfx/bgfx.h>
 
+#include <functional>
+#include <memory>
+#include <mutex>
+
 namespace Babylon::Graphics
 {
     class DeviceContext;
@@ -28,17 +32,56 @@ namespace Babylon::Graphics
         void Attach(bgfx::TextureHandle handle, bool ownsHandle, uint16_t width, uint16_t height, bool hasMips, uint16_t numLayers, bgfx::TextureFormat::Enum format, uint64_t flags);
         void Disown();
 
+        // Textures that native code shares with JavaScript, such as atlas pages, are only disposed by their native owner.
+        void MarkShared();
+        bool IsShared() const;
+
+        // Residency management. Textures with a restore callback can be evicted when the device context is over
+        // its texture memory budget, and are restored on demand the next time they are used. The restore callback
+        // runs on the thread pool to decode the contents and returns the upload, which runs on the JavaScript thread.
+        using UploadCallback = std::function<void(Texture&)>;
+        using RestoreCallback = std::function<UploadCallback()>;
+        void SetRestoreCallback(RestoreCallback callback);
+        bool IsEvictable() const;
+        bool IsEvicted() const;
+        void Evict();
+
+        // Starts restoring an evicted texture in the background and returns whether the texture is resident. Until it
+        // is, its handle is invalid and callers should bind a placeholder instead.
+        bool MakeResident();
+
+        // Restores an evicted texture on the calling thread, for callers that need its contents right away.
+        void MakeResidentNow();
+        void Touch();
+        uint32_t LastUseFrame() const;
+        size_t SizeInBytes() const;
+
         bgfx::TextureHandle Handle() const;
         uint16_t Width() const;
         uint16_t Height() const;
         bool HasMips() const;
         uint16_t NumLayers() const;
+        bool IsCubeMap() const;
         bgfx::TextureFormat::Enum Format() const;
         uint64_t Flags() const;
         uint32_t SamplerFlags() const;
         void SamplerFlags(uint32_t);
 
     private:
+        // Shared with the background restore, which may finish after the texture was disposed or destroyed.
+        struct RestoreState
+        {
+            std::mutex Mutex{};
+            RestoreCallback Callback{};
+            UploadCallback Upload{};
+            uint32_t Generation{0};
+            bool Restoring{false};
+            bool Evicted{false};
+        };
+
+        void Track();
+        void Upload(UploadCallback upload);
+
         bgfx::TextureHandle m_handle{bgfx::kInvalidHandle};
         bool m_ownsHandle{false};
         uint16_t m_width{0};
@@ -48,6 +91,11 @@ namespace Babylon::Graphics
         bgfx::TextureFormat::Enum m_format{bgfx::TextureFormat::Enum::Unknown};
         uint64_t m_flags{BGFX_TEXTURE_NONE};
         uint32_t m_samplerFlags{BGFX_SAMPLER_NONE};
+        bool m_cubeMap{false};
+        bool m_tracked{false};
+        bool m_shared{false};
+        uint32_t m_lastUseFrame{0};
+        const std::shared_ptr<RestoreState> m_restoreState{std::make_shared<RestoreState>()};
         uintptr_t m_deviceID;
         DeviceContext& m_deviceContext;
     };
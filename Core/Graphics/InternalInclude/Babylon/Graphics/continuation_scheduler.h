@@ -1,15 +1,151 @@
 #pragma once
 
-#include <arcana/threading/dispatcher.h>
+#include <arcana/functional/inplace_function.h>
+#include <arcana/threading/cancellation.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace Babylon
 {
-    template<size_t WorkSize = 128>
+    // Multi-producer single-consumer queue of small callables. Producers neither lock nor allocate as long as the
+    // preallocated ring has room. Work that doesn't fit goes to a locked overflow queue until the consumer drains it,
+    // which keeps the order of work queued from the same thread.
+    template<size_t WorkSize, size_t Capacity>
+    class mpsc_work_queue
+    {
+        static_assert(Capacity != 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    public:
+        using callback_t = stdext::inplace_function<void(), WorkSize>;
+
+        mpsc_work_queue()
+            : m_cells{std::make_unique<cell[]>(Capacity)}
+        {
+            for (size_t index = 0; index < Capacity; ++index)
+            {
+                m_cells[index].sequence.store(index, std::memory_order_relaxed);
+            }
+        }
+
+        mpsc_work_queue(const mpsc_work_queue&) = delete;
+        mpsc_work_queue& operator=(const mpsc_work_queue&) = delete;
+
+        template<typename CallableT>
+        void push(CallableT&& callable)
+        {
+            if (!m_overflowing.load(std::memory_order_acquire))
+            {
+                size_t position{m_enqueuePosition.load(std::memory_order_relaxed)};
+                while (true)
+                {
+                    cell& slot{m_cells[position & (Capacity - 1)]};
+                    const size_t sequence{slot.sequence.load(std::memory_order_acquire)};
+                    const auto difference{static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position)};
+                    if (difference == 0)
+                    {
+                        if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                        {
+                            slot.work = callback_t{std::forward<CallableT>(callable)};
+                            slot.sequence.store(position + 1, std::memory_order_release);
+                            return;
+                        }
+                    }
+                    else if (difference < 0)
+                    {
+                        // The ring is full.
+                        break;
+                    }
+                    else
+                    {
+                        position = m_enqueuePosition.load(std::memory_order_relaxed);
+                    }
+                }
+            }
+
+            std::scoped_lock lock{m_overflowMutex};
+            m_overflow.emplace_back(std::forward<CallableT>(callable));
+            m_overflowing.store(true, std::memory_order_release);
+        }
+
+        // Must only be called from the consuming thread.
+        bool try_pop(callback_t& work)
+        {
+            // Overflow work taken earlier is older than anything queued to the ring since.
+            if (m_pendingOverflowIndex < m_pendingOverflow.size())
+            {
+                work = std::move(m_pendingOverflow[m_pendingOverflowIndex++]);
+                return true;
+            }
+
+            cell& slot{m_cells[m_dequeuePosition & (Capacity - 1)]};
+            const size_t sequence{slot.sequence.load(std::memory_order_acquire)};
+            if (sequence == m_dequeuePosition + 1)
+            {
+                work = std::move(slot.work);
+                slot.work = nullptr;
+                slot.sequence.store(m_dequeuePosition + Capacity, std::memory_order_release);
+                ++m_dequeuePosition;
+                return true;
+            }
+
+            // A producer claimed the cell but has not published its work yet. Work queued to the ring behind it can be
+            // older than the overflow work, so the overflow is only drained once the ring is empty.
+            if (m_enqueuePosition.load(std::memory_order_acquire) != m_dequeuePosition)
+            {
+                return false;
+            }
+
+            if (m_overflowing.load(std::memory_order_acquire))
+            {
+                m_pendingOverflow.clear();
+                m_pendingOverflowIndex = 0;
+
+                {
+                    std::scoped_lock lock{m_overflowMutex};
+                    m_pendingOverflow.swap(m_overflow);
+                    m_overflowing.store(false, std::memory_order_release);
+                }
+
+                if (!m_pendingOverflow.empty())
+                {
+                    work = std::move(m_pendingOverflow[m_pendingOverflowIndex++]);
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+    private:
+        struct cell
+        {
+            std::atomic<size_t> sequence{};
+            callback_t work{};
+        };
+
+        std::unique_ptr<cell[]> m_cells;
+        alignas(64) std::atomic<size_t> m_enqueuePosition{0};
+        alignas(64) size_t m_dequeuePosition{0};
+
+        std::atomic<bool> m_overflowing{false};
+        std::mutex m_overflowMutex{};
+        std::vector<callback_t> m_overflow{};
+
+        // Overflow work taken by the consumer that has not run yet.
+        std::vector<callback_t> m_pendingOverflow{};
+        size_t m_pendingOverflowIndex{0};
+    };
+
+    template<size_t WorkSize = 128, size_t Capacity = 256>
     class continuation_scheduler
     {
     public:
-        continuation_scheduler(arcana::manual_dispatcher<WorkSize>& dispatcher)
-            : m_dispatcher{dispatcher}
+        continuation_scheduler(mpsc_work_queue<WorkSize, Capacity>& queue)
+            : m_queue{queue}
         {
         }
 
@@ -19,20 +155,20 @@ namespace Babylon
         template<typename CallableT>
         void operator()(CallableT&& callable)
         {
-            m_dispatcher(callable);
+            m_queue.push(std::forward<CallableT>(callable));
         }
 
     protected:
-        arcana::manual_dispatcher<WorkSize>& m_dispatcher;
+        mpsc_work_queue<WorkSize, Capacity>& m_queue;
     };
 
-    template<size_t WorkSize = 128>
+    template<size_t WorkSize = 128, size_t Capacity = 256>
     class continuation_dispatcher
     {
     public:
         continuation_dispatcher()
-            : m_dispatcher{}
-            , m_scheduler{m_dispatcher}
+            : m_queue{}
+            , m_scheduler{m_queue}
         {
         }
 
@@ -41,13 +177,20 @@ namespace Babylon
             return m_scheduler;
         }
 
+        // Runs queued work, including work queued while ticking, until the queue is empty or the cancellation is cancelled.
+        // Work still being queued by another thread when the tick ends runs on the next tick.
         void tick(const arcana::cancellation& cancellation)
         {
-            m_dispatcher.tick(cancellation);
+            typename mpsc_work_queue<WorkSize, Capacity>::callback_t work{};
+            while (!cancellation.cancelled() && m_queue.try_pop(work))
+            {
+                work();
+                work = nullptr;
+            }
         }
 
     private:
-        arcana::manual_dispatcher<WorkSize> m_dispatcher{};
-        continuation_scheduler<WorkSize> m_scheduler{};
+        mpsc_work_queue<WorkSize, Capacity> m_queue;
+        continuation_scheduler<WorkSize, Capacity> m_scheduler;
     };
 }
@@ -1,4 +1,5 @@
 #include "BgfxCallback.h"
+#include "PixelConversion.h"
 #include <bx/bx.h>
 #include <bx/string.h>
 #include <bx/platform.h>
@@ -16,6 +17,7 @@ namespace Babylon::Graphics
 
     void BgfxCallback::AddScreenShotCallback(std::function<void(std::vector<uint8_t>)> callback)
     {
+        std::scoped_lock lock{m_screenShotCallbacksMutex};
         m_screenShotCallbacks.emplace(std::move(callback));
     }
 
@@ -89,26 +91,19 @@ namespace Babylon::Graphics
 
     void BgfxCallback::screenShot(const char* /*filePath*/, uint32_t width, uint32_t height, uint32_t pitch, const void* data, uint32_t /*size*/, bool yflip)
     {
-        assert(!m_screenShotCallbacks.empty()); // addScreenShotCallback not called before doing the screenshot call on bgfx
-
-        std::vector<uint8_t> array(width * height * 4); // do not use pitch to define output size because it's padded
-        uint8_t* bitmap{array.data()};
-
-        for (uint32_t py = 0; py < height; py++)
+        std::function<void(std::vector<uint8_t>)> callback{};
         {
-            const uint8_t* ptr = static_cast<const uint8_t*>(data) + (yflip ? (height - py - 1) : py) * pitch;
-            for (uint32_t px = 0; px < width; px++)
-            {
-                // bgfx screenshot is BGRA
-                *bitmap++ = ptr[px * 4 + 2];
-                *bitmap++ = ptr[px * 4 + 1];
-                *bitmap++ = ptr[px * 4 + 0];
-                *bitmap++ = ptr[px * 4 + 3];
-            }
+            std::scoped_lock lock{m_screenShotCallbacksMutex};
+            assert(!m_screenShotCallbacks.empty()); // addScreenShotCallback not called before doing the screenshot call on bgfx
+            callback = std::move(m_screenShotCallbacks.front());
+            m_screenShotCallbacks.pop();
         }
 
-        m_screenShotCallbacks.front()(std::move(array));
-        m_screenShotCallbacks.pop();
+        // bgfx screenshot is BGRA, convert it to tightly packed RGBA in the buffer handed to the callback.
+        std::vector<uint8_t> array(width * height * 4);
+        CopyPixels32(static_cast<const uint8_t*>(data), pitch, array.data(), width * 4, width, height, true, yflip);
+
+        callback(std::move(array));
     }
 
     void BgfxCallback::captureBegin(uint32_t width, uint32_t height, uint32_t pitch, bgfx::TextureFormat::Enum format, bool yflip)
@@ -0,0 +1,296 @@
+#include "BgfxContext.h"
+#include "DeviceImpl.h"
+
+#include <bgfx/platform.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+    // Views per device, so that a few devices fit in the bgfx view limit with enough views each.
+    constexpr uint32_t VIEW_RANGE_SIZE{64};
+
+    // Devices of this thread that are recording.
+    thread_local uint32_t t_recordingDevices{};
+}
+
+namespace Babylon::Graphics
+{
+    BgfxContext& BgfxContext::Get()
+    {
+        static BgfxContext context{};
+        return context;
+    }
+
+    void BgfxContext::Attach(DeviceImpl& device, const bgfx::Init& init, bool multithreaded)
+    {
+        std::scoped_lock lock{m_mutex};
+
+        if (m_attachments.empty())
+        {
+            // Calling renderFrame before init tells bgfx to not create its own render thread.
+            if (!multithreaded)
+            {
+                bgfx::renderFrame();
+            }
+
+            {
+                std::scoped_lock callbackLock{m_callbackMutex};
+                m_callback = init.callback;
+            }
+
+            bgfx::Init sharedInit{init};
+            sharedInit.callback = this;
+
+            bgfx::setPlatformData(init.platformData);
+            bgfx::init(sharedInit);
+
+            m_owner = &device;
+            m_multithreaded = multithreaded;
+            m_rendererType = bgfx::getRendererType();
+        }
+        else if (multithreaded != m_multithreaded)
+        {
+            throw std::runtime_error{"Devices in the same process must all use multithreaded rendering or none of them."};
+        }
+        else if (init.type != bgfx::RendererType::Count && init.type != m_rendererType)
+        {
+            throw std::runtime_error{"Devices in the same process must use the same renderer type."};
+        }
+
+        // Takes the first view range that no other device uses.
+        uint32_t viewRangeIndex{0};
+        while (std::any_of(m_attachments.begin(), m_attachments.end(), [viewRangeIndex](const auto& attachment) { return attachment.ViewRangeIndex == viewRangeIndex; }))
+        {
+            ++viewRangeIndex;
+        }
+
+        if (viewRangeIndex * VIEW_RANGE_SIZE >= DeviceContext::GetBlitViewId())
+        {
+            throw std::runtime_error{"Too many devices in the same process, they ran out of views."};
+        }
+
+        m_attachments.push_back({&device, init.callback, viewRangeIndex});
+    }
+
+    void BgfxContext::Detach(DeviceImpl& device)
+    {
+        std::unique_lock lock{m_mutex};
+
+        const auto it{std::find_if(m_attachments.begin(), m_attachments.end(), [&device](const auto& attachment) { return attachment.Device == &device; })};
+        if (it == m_attachments.end())
+        {
+            return;
+        }
+
+        m_attachments.erase(it);
+        if (m_recording.erase(&device) != 0)
+        {
+            --t_recordingDevices;
+        }
+
+        if (m_attachments.empty())
+        {
+            bgfx::shutdown();
+            m_owner = nullptr;
+            m_submitPending = false;
+            m_submitted.notify_all();
+
+            {
+                std::scoped_lock callbackLock{m_callbackMutex};
+                m_callback = nullptr;
+            }
+
+            std::scoped_lock cacheLock{m_cacheMutex};
+            m_cache.clear();
+            return;
+        }
+
+        if (m_owner == &device)
+        {
+            // The next device takes over submitting frames and resets the back buffer with its own platform data.
+            m_owner = m_attachments.front().Device;
+
+            std::scoped_lock callbackLock{m_callbackMutex};
+            m_callback = m_attachments.front().Callback;
+        }
+
+        // The device may have been the last one a requested frame was waiting for.
+        SubmitIfReady(lock);
+    }
+
+    bool BgfxContext::IsOwner(const DeviceImpl& device) const
+    {
+        std::scoped_lock lock{m_mutex};
+        return m_owner == &device;
+    }
+
+    void BgfxContext::BeginFrame(DeviceImpl& device)
+    {
+        std::unique_lock lock{m_mutex};
+
+        // Views are reset when a frame is submitted, so nothing is recorded while it is. A thread that is already recording
+        // for another device doesn't wait for a requested frame, as that frame waits for the other device to end.
+        m_submitted.wait(lock, [this]() { return !m_submitting && (!m_submitPending || t_recordingDevices != 0); });
+
+        if (m_recording.insert(&device).second)
+        {
+            ++t_recordingDevices;
+        }
+    }
+
+    uint32_t BgfxContext::Frame(DeviceImpl& device)
+    {
+        std::unique_lock lock{m_mutex};
+
+        if (m_recording.erase(&device) != 0)
+        {
+            --t_recordingDevices;
+        }
+
+        // Only the owner requests frames, what the other devices recorded goes into the next one.
+        if (m_owner == &device)
+        {
+            m_submitPending = true;
+        }
+
+        SubmitIfReady(lock);
+        return m_frameNumber;
+    }
+
+    void BgfxContext::SubmitIfReady(std::unique_lock<std::mutex>& lock)
+    {
+        if (!m_submitPending || m_submitting || !m_recording.empty())
+        {
+            return;
+        }
+
+        m_submitPending = false;
+        m_submitting = true;
+
+        // Rendering can invoke callbacks that need to query the context.
+        lock.unlock();
+        const uint32_t frameNumber{bgfx::frame()};
+        lock.lock();
+
+        // All the views recorded so far were part of the frame.
+        for (const auto& attachment : m_attachments)
+        {
+            attachment.Device->ResetViews();
+        }
+
+        m_frameNumber = frameNumber;
+        m_submitting = false;
+        m_submitted.notify_all();
+    }
+
+    BgfxContext::ViewRange BgfxContext::GetViewRange(const DeviceImpl& device) const
+    {
+        std::scoped_lock lock{m_mutex};
+
+        const auto it{std::find_if(m_attachments.begin(), m_attachments.end(), [&device](const auto& attachment) { return attachment.Device == &device; })};
+        if (it == m_attachments.end())
+        {
+            return {0, 0};
+        }
+
+        const uint32_t first{it->ViewRangeIndex * VIEW_RANGE_SIZE};
+        const uint32_t size{std::min<uint32_t>(VIEW_RANGE_SIZE, DeviceContext::GetBlitViewId() - first)};
+        return {static_cast<bgfx::ViewId>(first), static_cast<uint16_t>(size)};
+    }
+
+    void BgfxContext::fatal(const char* filePath, uint16_t line, bgfx::Fatal::Enum code, const char* str)
+    {
+        std::scoped_lock lock{m_callbackMutex};
+        if (m_callback)
+        {
+            m_callback->fatal(filePath, line, code, str);
+        }
+    }
+
+    void BgfxContext::traceVargs(const char* filePath, uint16_t line, const char* format, va_list argList)
+    {
+        std::scoped_lock lock{m_callbackMutex};
+        if (m_callback)
+        {
+            m_callback->traceVargs(filePath, line, format, argList);
+        }
+    }
+
+    void BgfxContext::profilerBegin(const char* /*name*/, uint32_t /*abgr*/, const char* /*filePath*/, uint16_t /*line*/)
+    {
+    }
+
+    void BgfxContext::profilerBeginLiteral(const char* /*name*/, uint32_t /*abgr*/, const char* /*filePath*/, uint16_t /*line*/)
+    {
+    }
+
+    void BgfxContext::profilerEnd()
+    {
+    }
+
+    uint32_t BgfxContext::cacheReadSize(uint64_t id)
+    {
+        std::scoped_lock lock{m_cacheMutex};
+        const auto it{m_cache.find(id)};
+        return it == m_cache.end() ? 0 : static_cast<uint32_t>(it->second.size());
+    }
+
+    bool BgfxContext::cacheRead(uint64_t id, void* data, uint32_t size)
+    {
+        std::scoped_lock lock{m_cacheMutex};
+        const auto it{m_cache.find(id)};
+        if (it == m_cache.end() || it->second.size() != size)
+        {
+            return false;
+        }
+
+        std::memcpy(data, it->second.data(), size);
+        return true;
+    }
+
+    void BgfxContext::cacheWrite(uint64_t id, const void* data, uint32_t size)
+    {
+        const auto* bytes{static_cast<const uint8_t*>(data)};
+        std::scoped_lock lock{m_cacheMutex};
+        m_cache[id].assign(bytes, bytes + size);
+    }
+
+    void BgfxContext::screenShot(const char* filePath, uint32_t width, uint32_t height, uint32_t pitch, const void* data, uint32_t size, bool yflip)
+    {
+        std::scoped_lock lock{m_callbackMutex};
+        if (m_callback)
+        {
+            m_callback->screenShot(filePath, width, height, pitch, data, size, yflip);
+        }
+    }
+
+    void BgfxContext::captureBegin(uint32_t width, uint32_t height, uint32_t pitch, bgfx::TextureFormat::Enum format, bool yflip)
+    {
+        std::scoped_lock lock{m_callbackMutex};
+        if (m_callback)
+        {
+            m_callback->captureBegin(width, height, pitch, format, yflip);
+        }
+    }
+
+    void BgfxContext::captureEnd()
+    {
+        std::scoped_lock lock{m_callbackMutex};
+        if (m_callback)
+        {
+            m_callback->captureEnd();
+        }
+    }
+
+    void BgfxContext::captureFrame(const void* data, uint32_t size)
+    {
+        std::scoped_lock lock{m_callbackMutex};
+        if (m_callback)
+        {
+            m_callback->captureFrame(data, size);
+        }
+    }
+}
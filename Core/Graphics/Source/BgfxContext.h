@@ -0,0 +1,104 @@
+#pragma once
+
+#include <bgfx/bgfx.h>
+
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Babylon::Graphics
+{
+    class DeviceImpl;
+
+    // bgfx is a process-wide singleton, so devices in the same process share one bgfx context. The first device to start
+    // rendering initializes it and owns the back buffer, screen shots and capture; the other devices render offscreen.
+    // Only the owner requests frames, and the other devices contribute to the next one whenever they have work. bgfx::frame
+    // waits for every open encoder, so a requested frame is submitted once no device is between BeginFrame and Frame.
+    // Each device renders into its own fixed range of view ids.
+    class BgfxContext final : bgfx::CallbackI
+    {
+    public:
+        static BgfxContext& Get();
+
+        BgfxContext(const BgfxContext&) = delete;
+        BgfxContext& operator=(const BgfxContext&) = delete;
+
+        // Initializes bgfx for the first device. The bgfx callbacks are forwarded to the callback in the init state of the owner.
+        void Attach(DeviceImpl& device, const bgfx::Init& init, bool multithreaded);
+
+        // Shuts bgfx down when the last device detaches, otherwise hands ownership to another device.
+        void Detach(DeviceImpl& device);
+
+        bool IsOwner(const DeviceImpl& device) const;
+
+        // The device records until its Frame. Waits for a requested frame to be submitted first, unless the thread is
+        // recording for another device, which the submission waits for in turn.
+        void BeginFrame(DeviceImpl& device);
+
+        // Ends recording for the device and requests a frame if the device is the owner. The frame is submitted right
+        // away when no other device is recording, otherwise by the last of them to end. Returns the number of the last
+        // submitted frame.
+        uint32_t Frame(DeviceImpl& device);
+
+        struct ViewRange
+        {
+            bgfx::ViewId First;
+            uint16_t Size;
+        };
+
+        // The view ids of the device, fixed while it is attached. The blit view is never part of a range.
+        ViewRange GetViewRange(const DeviceImpl& device) const;
+
+    private:
+        BgfxContext() = default;
+
+        // Submits the requested frame if no device is recording, then resets the views of all devices.
+        void SubmitIfReady(std::unique_lock<std::mutex>& lock);
+
+        void fatal(const char* filePath, uint16_t line, bgfx::Fatal::Enum code, const char* str) override;
+        void traceVargs(const char* filePath, uint16_t line, const char* format, va_list argList) override;
+        void profilerBegin(const char* name, uint32_t abgr, const char* filePath, uint16_t line) override;
+        void profilerBeginLiteral(const char* name, uint32_t abgr, const char* filePath, uint16_t line) override;
+        void profilerEnd() override;
+        uint32_t cacheReadSize(uint64_t id) override;
+        bool cacheRead(uint64_t id, void* data, uint32_t size) override;
+        void cacheWrite(uint64_t id, const void* data, uint32_t size) override;
+        void screenShot(const char* filePath, uint32_t width, uint32_t height, uint32_t pitch, const void* data, uint32_t size, bool yflip) override;
+        void captureBegin(uint32_t width, uint32_t height, uint32_t pitch, bgfx::TextureFormat::Enum format, bool yflip) override;
+        void captureEnd() override;
+        void captureFrame(const void* data, uint32_t size) override;
+
+        struct Attachment
+        {
+            DeviceImpl* Device{};
+            bgfx::CallbackI* Callback{};
+            uint32_t ViewRangeIndex{};
+        };
+
+        mutable std::mutex m_mutex{};
+        std::vector<Attachment> m_attachments{};
+        DeviceImpl* m_owner{};
+        bool m_multithreaded{};
+        bgfx::RendererType::Enum m_rendererType{bgfx::RendererType::Count};
+
+        uint32_t m_frameNumber{};
+
+        // Devices between BeginFrame and Frame, whose encoders may be open.
+        std::unordered_set<const DeviceImpl*> m_recording{};
+        bool m_submitPending{};
+        bool m_submitting{};
+        std::condition_variable m_submitted{};
+
+        // Guards forwarding bgfx callbacks to the owner, which can run on the bgfx render thread.
+        std::mutex m_callbackMutex{};
+        bgfx::CallbackI* m_callback{};
+
+        // Shader binaries compiled by the renderer, shared by all devices.
+        std::mutex m_cacheMutex{};
+        std::unordered_map<uint64_t, std::vector<uint8_t>> m_cache{};
+    };
+}
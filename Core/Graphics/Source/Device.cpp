@@ -39,6 +39,16 @@ namespace Babylon::Graphics
         m_impl->UpdateAlphaPremultiplied(enabled);
     }
 
+    void Device::UpdateDisplayMetrics()
+    {
+        m_impl->UpdateDisplayMetrics();
+    }
+
+    void Device::SetDevicePixelRatioChangedCallback(std::function<void(float)> callback)
+    {
+        m_impl->SetDevicePixelRatioChangedCallback(std::move(callback));
+    }
+
     void Device::AddToJavaScript(Napi::Env env)
     {
         m_impl->AddToJavaScript(env);
@@ -74,6 +84,7 @@ namespace Babylon::Graphics
 
     void Device::StartRenderingCurrentFrame()
     {
+        m_impl->WaitForFrameStart();
         m_impl->StartRenderingCurrentFrame();
     }
 
@@ -82,6 +93,31 @@ namespace Babylon::Graphics
         m_impl->FinishRenderingCurrentFrame();
     }
 
+    void Device::RenderFrame(DeviceUpdate& update)
+    {
+        StartRenderingCurrentFrame();
+        update.Start();
+        update.Finish();
+        FinishRenderingCurrentFrame();
+    }
+
+    std::future<ReadBackImage> Device::ReadBackAsync()
+    {
+        auto promise{std::make_shared<std::promise<ReadBackImage>>()};
+        m_impl->ReadBackAsync().then(arcana::inline_scheduler, arcana::cancellation::none(), [promise](const arcana::expected<ReadBackImage, std::exception_ptr>& result) {
+            if (result.has_error())
+            {
+                promise->set_exception(result.error());
+            }
+            else
+            {
+                promise->set_value(result.value());
+            }
+        });
+
+        return promise->get_future();
+    }
+
     void Device::SetDiagnosticOutput(std::function<void(const char* output)> outputFunction)
     {
         m_impl->SetDiagnosticOutput(std::move(outputFunction));
@@ -102,6 +138,21 @@ namespace Babylon::Graphics
         return m_impl->GetDevicePixelRatio();
     }
 
+    void Device::SetDynamicResolution(const DynamicResolutionConfiguration& config)
+    {
+        m_impl->SetDynamicResolution(config);
+    }
+
+    float Device::GetRenderScale() const
+    {
+        return m_impl->GetRenderScale();
+    }
+
+    void Device::SetFramePacing(const FramePacingConfiguration& config)
+    {
+        m_impl->SetFramePacing(config);
+    }
+
     PlatformInfo Device::GetPlatformInfo() const
     {
         return m_impl->GetPlatformInfo();
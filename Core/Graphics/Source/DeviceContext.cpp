@@ -1,9 +1,19 @@
 #include "DeviceContext.h"
 
 #include "DeviceImpl.h"
+#include "Texture.h"
 
 #include <napi/napi_pointer.h>
 
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+    // Textures used within this many frames are never evicted.
+    constexpr uint32_t TEXTURE_EVICTION_MIN_IDLE_FRAMES{60};
+}
+
 namespace Babylon::Graphics
 {
     UpdateToken::UpdateToken(DeviceContext& context, SafeTimespanGuarantor& guarantor)
@@ -81,6 +91,21 @@ namespace Babylon::Graphics
         m_graphicsImpl.SetHardwareScalingLevel(level);
     }
 
+    float DeviceContext::GetRenderScale() const
+    {
+        return m_graphicsImpl.GetRenderScale();
+    }
+
+    float DeviceContext::GetRenderScalingLevel() const
+    {
+        return m_graphicsImpl.GetRenderScalingLevel();
+    }
+
+    void DeviceContext::SetDynamicResolution(const DynamicResolutionConfiguration& config)
+    {
+        m_graphicsImpl.SetDynamicResolution(config);
+    }
+
     size_t DeviceContext::GetWidth() const
     {
         return m_graphicsImpl.GetWidth();
@@ -106,23 +131,171 @@ namespace Babylon::Graphics
         return m_graphicsImpl.AcquireNewViewId(encoder);
     }
 
+    bgfx::ViewId DeviceContext::GetBlitViewId()
+    {
+        return static_cast<bgfx::ViewId>(bgfx::getCaps()->limits.maxViews - 1);
+    }
+
+    bool DeviceContext::IsLastViewId(bgfx::ViewId viewId) const
+    {
+        return m_graphicsImpl.IsLastViewId(viewId);
+    }
+
+    bgfx::FrameBufferHandle DeviceContext::GetBackBufferHandle() const
+    {
+        return m_graphicsImpl.GetBackBufferHandle();
+    }
+
     void DeviceContext::AddTexture(bgfx::TextureHandle handle, uint16_t width, uint16_t height, bool hasMips, uint16_t numLayers, bgfx::TextureFormat::Enum format)
     {
-        std::scoped_lock lock{m_textureHandleToInfoMutex};
-        TextureInfo textureInfo{width, height, hasMips, numLayers, format};
-        m_textureHandleToInfo.emplace(handle.idx, textureInfo);
+        bgfx::TextureInfo info{};
+        bgfx::calcTextureSize(info, width, height, /*depth*/ 1, /*cubeMap*/ false, hasMips, std::max<uint16_t>(numLayers, 1), format);
+        AddTextureRecord(handle, {{width, height, hasMips, numLayers, format}, info.storageSize, nullptr});
     }
 
     void DeviceContext::RemoveTexture(bgfx::TextureHandle handle)
     {
         std::scoped_lock lock{m_textureHandleToInfoMutex};
-        m_textureHandleToInfo.erase(handle.idx);
+        auto it{m_textureHandleToInfo.find(handle.idx)};
+        if (it != m_textureHandleToInfo.end())
+        {
+            m_textureMemoryUsage -= it->second.Bytes;
+            m_textureHandleToInfo.erase(it);
+        }
     }
 
     TextureInfo DeviceContext::GetTextureInfo(bgfx::TextureHandle handle)
     {
         std::scoped_lock lock{m_textureHandleToInfoMutex};
-        return m_textureHandleToInfo[handle.idx];
+        return m_textureHandleToInfo[handle.idx].Info;
+    }
+
+    void DeviceContext::AddTexture(Texture& texture)
+    {
+        TextureInfo textureInfo{texture.Width(), texture.Height(), texture.HasMips(), texture.NumLayers(), texture.Format()};
+        AddTextureRecord(texture.Handle(), {textureInfo, texture.SizeInBytes(), &texture});
+    }
+
+    void DeviceContext::RemoveTexture(Texture& texture)
+    {
+        std::scoped_lock lock{m_textureHandleToInfoMutex};
+
+        // Handles can be reused after a device reset, so only remove the record if it still belongs to this texture.
+        auto it{m_textureHandleToInfo.find(texture.Handle().idx)};
+        if (it != m_textureHandleToInfo.end() && it->second.Owner == &texture)
+        {
+            m_textureMemoryUsage -= it->second.Bytes;
+            m_textureHandleToInfo.erase(it);
+        }
+    }
+
+    size_t DeviceContext::GetTextureMemoryBudget() const
+    {
+        return m_graphicsImpl.GetTextureMemoryBudget();
+    }
+
+    void DeviceContext::SetTextureMemoryBudget(size_t bytes)
+    {
+        m_graphicsImpl.SetTextureMemoryBudget(bytes);
+    }
+
+    TextureMemoryStats DeviceContext::GetTextureMemoryStats() const
+    {
+        std::scoped_lock lock{m_textureHandleToInfoMutex};
+        return {m_textureMemoryUsage, m_graphicsImpl.GetTextureMemoryBudget(), m_textureEvictionCount};
+    }
+
+    void DeviceContext::EnforceTextureMemoryBudget()
+    {
+        const size_t budget{m_graphicsImpl.GetTextureMemoryBudget()};
+        if (budget == 0)
+        {
+            return;
+        }
+
+        const uint32_t frameNumber{GetFrameNumber()};
+        std::vector<Texture*> candidates{};
+        size_t excess{};
+
+        {
+            std::scoped_lock lock{m_textureHandleToInfoMutex};
+            if (m_textureMemoryUsage <= budget)
+            {
+                return;
+            }
+
+            excess = m_textureMemoryUsage - budget;
+
+            for (const auto& [idx, record] : m_textureHandleToInfo)
+            {
+                if (record.Owner != nullptr && record.Owner->IsEvictable() && frameNumber - record.Owner->LastUseFrame() >= TEXTURE_EVICTION_MIN_IDLE_FRAMES)
+                {
+                    candidates.push_back(record.Owner);
+                }
+            }
+        }
+
+        // Evict the least recently used textures first.
+        std::sort(candidates.begin(), candidates.end(), [](const Texture* a, const Texture* b) {
+            return a->LastUseFrame() < b->LastUseFrame();
+        });
+
+        size_t freed{};
+        size_t evicted{};
+        for (Texture* texture : candidates)
+        {
+            if (freed >= excess)
+            {
+                break;
+            }
+
+            freed += texture->SizeInBytes();
+            texture->Evict();
+            ++evicted;
+        }
+
+        std::scoped_lock lock{m_textureHandleToInfoMutex};
+        m_textureEvictionCount += evicted;
+    }
+
+    uint32_t DeviceContext::GetFrameNumber() const
+    {
+        return m_graphicsImpl.GetFrameNumber();
+    }
+
+    bool DeviceContext::IsMultithreaded() const
+    {
+        return m_graphicsImpl.IsMultithreaded();
+    }
+
+    FrameStats DeviceContext::GetFrameStats() const
+    {
+        return m_graphicsImpl.GetFrameStats();
+    }
+
+    void DeviceContext::AddTextureUploadStats(uint64_t uploadedBytes, uint64_t savedBytes)
+    {
+        m_graphicsImpl.AddTextureUploadStats(uploadedBytes, savedBytes);
+    }
+
+    void DeviceContext::AddCanvasStats(const CanvasStats& stats)
+    {
+        m_graphicsImpl.AddCanvasStats(stats);
+    }
+
+    void DeviceContext::AddTextureRecord(bgfx::TextureHandle handle, TextureRecord record)
+    {
+        std::scoped_lock lock{m_textureHandleToInfoMutex};
+
+        // Replace any stale record left behind by a handle from a previous device.
+        auto [it, inserted] = m_textureHandleToInfo.try_emplace(handle.idx, record);
+        if (!inserted)
+        {
+            m_textureMemoryUsage -= it->second.Bytes;
+            it->second = record;
+        }
+
+        m_textureMemoryUsage += record.Bytes;
     }
 
     uintptr_t DeviceContext::GetDeviceId() const
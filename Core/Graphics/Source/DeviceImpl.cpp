@@ -1,4 +1,6 @@
 #include "DeviceImpl.h"
+#include "BgfxContext.h"
+#include "PixelConversion.h"
 
 #include <Babylon/Graphics/Platform.h>
 #include <Babylon/Graphics/RendererType.h>
@@ -6,10 +8,20 @@
 #include <Babylon/JsRuntime.h>
 #include <arcana/tracing/trace_region.h>
 
+#include <bgfx/embedded_shader.h>
+#include <bx/math.h>
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
 #if defined(__APPLE__)
 #include <TargetConditionals.h>
 #endif
 
+#include "vs_ocornut_imgui.bin.h"
+#include "fs_ocornut_imgui.bin.h"
+
 #ifdef BABYLON_NATIVE_CHECK_THREAD_AFFINITY
 #define ASSERT_THREAD_AFFINITY(affinity) assert(affinity.check())
 #else
@@ -19,12 +31,78 @@
 namespace
 {
     constexpr auto JS_GRAPHICS_NAME = "_Graphics";
+
+    // The imgui shaders draw a textured quad given in pixels, which is all the upscale needs.
+    const bgfx::EmbeddedShader s_embeddedShaders[]{
+        BGFX_EMBEDDED_SHADER(vs_ocornut_imgui),
+        BGFX_EMBEDDED_SHADER(fs_ocornut_imgui),
+
+        BGFX_EMBEDDED_SHADER_END()};
+
+    struct UpscaleVertex
+    {
+        float X;
+        float Y;
+        float U;
+        float V;
+        uint32_t Color;
+    };
+
+    // Read backs complete a couple of frames after they are requested, so a few read back textures are in flight at once.
+    constexpr size_t MAX_IDLE_READ_BACK_TEXTURES{4};
+
+    // Frames without a size change after which a deferred back buffer resize is applied.
+    constexpr uint32_t BACK_BUFFER_RESIZE_SETTLE_FRAMES{10};
+
+    // Every render scale change reallocates the scaled render target, so changes are quantized and rate limited.
+    constexpr float DYNAMIC_RESOLUTION_STEP{0.05f};
+    constexpr uint32_t DYNAMIC_RESOLUTION_MIN_FRAMES_BETWEEN_CHANGES{30};
+    constexpr float DYNAMIC_RESOLUTION_SMOOTHING{0.1f};
+
+    // The scale is only raised when frames are this much faster than the target, to avoid oscillating around it.
+    constexpr float DYNAMIC_RESOLUTION_HEADROOM{0.85f};
+
+    constexpr float FRAME_PACING_SMOOTHING{0.1f};
+
+    // Time left before the deadline when a late latched frame starts, on top of the predicted work time.
+    constexpr std::chrono::microseconds FRAME_PACING_LATE_LATCH_MARGIN{1500};
+
+    // Sleeping is imprecise, so the last part of a wait spins.
+    constexpr std::chrono::microseconds FRAME_PACING_SPIN_DURATION{2000};
+
+    void WaitUntil(std::chrono::steady_clock::time_point time)
+    {
+        const auto sleepUntil{time - FRAME_PACING_SPIN_DURATION};
+        if (std::chrono::steady_clock::now() < sleepUntil)
+        {
+            std::this_thread::sleep_until(sleepUntil);
+        }
+
+        while (std::chrono::steady_clock::now() < time)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    float Smooth(float smoothed, float value)
+    {
+        return smoothed == 0.0f ? value : smoothed + (value - smoothed) * FRAME_PACING_SMOOTHING;
+    }
+
+    float ToMilliseconds(std::chrono::steady_clock::duration duration)
+    {
+        return std::chrono::duration<float, std::milli>(duration).count();
+    }
 }
 
 namespace Babylon::Graphics
 {
     DeviceImpl::DeviceImpl(const Configuration& config)
-        : m_bgfxCallback{[this](const auto& data) { CaptureCallback(data); }}
+        : m_multithreaded{config.MultithreadedRendering}
+        , m_offscreen{config.Offscreen}
+        , m_backBufferResizeThreshold{config.BackBufferResizeThreshold}
+        , m_textureMemoryBudget{config.TextureMemoryBudget}
+        , m_bgfxCallback{[this](const auto& data) { CaptureCallback(data); }}
         , m_context{*this}
         , m_bgfxId{0}
     {
@@ -33,21 +111,24 @@ namespace Babylon::Graphics
 
         auto& init = m_state.Bgfx.InitState;
         init.type = s_bgfxRenderType;
-        init.resolution.reset = BGFX_RESET_VSYNC | BGFX_RESET_MAXANISOTROPY | BGFX_RESET_FLIP_AFTER_RENDER;
-        init.resolution.maxFrameLatency = 1;
+        init.resolution.reset = BGFX_RESET_MAXANISOTROPY | BGFX_RESET_FLIP_AFTER_RENDER;
+        init.resolution.maxFrameLatency = config.MaxFrameLatency;
 
         init.callback = &m_bgfxCallback;
 
         init.platformData.context = config.Device;
-        UpdateWindow(config.Window);
+        UpdateWindow(m_offscreen ? WindowT{} : config.Window);
         UpdateSize(config.Width, config.Height);
         UpdateMSAA(config.MSAASamples);
         UpdateAlphaPremultiplied(config.AlphaPremultiplied);
+        SetDynamicResolution(config.DynamicResolution);
+        SetFramePacing(config.FramePacing);
     }
 
     DeviceImpl::~DeviceImpl()
     {
         DisableRendering();
+        ReleaseDisplayMetrics(m_state.NativeWindow);
     }
 
     uintptr_t DeviceImpl::GetId() const
@@ -59,6 +140,12 @@ namespace Babylon::Graphics
     {
         std::scoped_lock lock{m_state.Mutex};
         m_state.Bgfx.Dirty = true;
+        if (window != m_state.NativeWindow)
+        {
+            ReleaseDisplayMetrics(m_state.NativeWindow);
+        }
+
+        m_state.NativeWindow = window;
         ConfigureBgfxPlatformData(m_state.Bgfx.InitState.platformData, window);
         ConfigureBgfxRenderType(m_state.Bgfx.InitState.platformData, m_state.Bgfx.InitState.type);
         m_state.Resolution.DevicePixelRatio = GetDevicePixelRatio(window);
@@ -75,7 +162,15 @@ namespace Babylon::Graphics
         std::scoped_lock lock{m_state.Mutex};
         m_state.Resolution.Width = width;
         m_state.Resolution.Height = height;
-        UpdateBgfxResolution();
+        m_state.Resolution.ResizePending = true;
+        m_state.Resolution.ResizeFrameNumber = m_frameNumber.load();
+
+        // Resizes are coalesced and applied at the start of the next frame, unless there is nothing rendering yet.
+        if (!m_state.Bgfx.Initialized)
+        {
+            UpdateBackBufferSize();
+            UpdateFrameSize();
+        }
     }
 
     void DeviceImpl::UpdateMSAA(uint8_t value)
@@ -124,11 +219,41 @@ namespace Babylon::Graphics
         m_state.Resolution.DevicePixelRatio = value;
     }
 
+    void DeviceImpl::UpdateDisplayMetrics()
+    {
+        float devicePixelRatio{};
+        std::function<void(float)> callback{};
+        {
+            std::scoped_lock lock{m_state.Mutex};
+            InvalidateDisplayMetrics(m_state.NativeWindow);
+            devicePixelRatio = GetDevicePixelRatio(m_state.NativeWindow);
+            if (devicePixelRatio == m_state.Resolution.DevicePixelRatio)
+            {
+                return;
+            }
+
+            // The pixel ratio doesn't affect the back buffer, so there is no need to reset.
+            m_state.Resolution.DevicePixelRatio = devicePixelRatio;
+            callback = m_devicePixelRatioChangedCallback;
+        }
+
+        if (callback)
+        {
+            callback(devicePixelRatio);
+        }
+    }
+
     void DeviceImpl::SetRenderResetCallback(std::function<void()> callback)
     {
         m_renderResetCallback = std::move(callback);
     }
 
+    void DeviceImpl::SetDevicePixelRatioChangedCallback(std::function<void(float)> callback)
+    {
+        std::scoped_lock lock{m_state.Mutex};
+        m_devicePixelRatioChangedCallback = std::move(callback);
+    }
+
     void DeviceImpl::AddToJavaScript(Napi::Env env)
     {
         JsRuntime::NativeObject::GetFromJavaScript(env)
@@ -157,16 +282,18 @@ namespace Babylon::Graphics
             // Set the thread affinity (all other rendering operations must happen on this thread).
             m_renderThreadAffinity = std::this_thread::get_id();
 
-            // This tells bgfx to not create its own render thread.
-            bgfx::renderFrame();
-
-            // Initialize bgfx.
-            auto& init{m_state.Bgfx.InitState};
-            bgfx::setPlatformData(init.platformData);
-            bgfx::init(init);
+            // Initialize bgfx, or share it with the devices that are already rendering. In multithreaded mode bgfx owns
+            // renderFrame on its render thread and bgfx::frame only hands the recorded frame over. The update safe
+            // timespans still bracket bgfx::frame on this thread, so updates never overlap the hand over.
+            BgfxContext::Get().Attach(*this, m_state.Bgfx.InitState, m_multithreaded);
 
             m_state.Bgfx.Initialized = true;
             m_state.Bgfx.Dirty = false;
+            m_state.Bgfx.OwnsBackBuffer = BgfxContext::Get().IsOwner(*this);
+
+            const auto viewRange{BgfxContext::Get().GetViewRange(*this)};
+            m_firstViewId = viewRange.First;
+            m_viewIdCount = viewRange.Size;
 
             m_cancellationSource.emplace();
 
@@ -188,12 +315,30 @@ namespace Babylon::Graphics
 
         if (m_state.Bgfx.Initialized)
         {
-            // Drain readTextures queue, completing them in an error state.
-            while (!m_readTextureRequests.empty())
+            // Fail read backs that have not been issued yet, and drain the readTextures queue, completing them in an error state.
             {
-                auto error = arcana::make_unexpected(std::make_exception_ptr(std::system_error(std::make_error_code(std::errc::operation_canceled))));
-                m_readTextureRequests.front().second.complete(error);
-                m_readTextureRequests.pop();
+                std::scoped_lock readBackLock{m_readBackRequestsMutex};
+                for (auto& request : m_readBackRequests)
+                {
+                    request.complete(arcana::make_unexpected(std::make_exception_ptr(std::system_error(std::make_error_code(std::errc::operation_canceled)))));
+                }
+                m_readBackRequests.clear();
+            }
+
+            {
+                std::scoped_lock readTextureLock{m_readTextureRequestsMutex};
+                for (auto& request : m_pendingReadTextureRequests)
+                {
+                    request.CompletionSource.complete(arcana::make_unexpected(std::make_exception_ptr(std::system_error(std::make_error_code(std::errc::operation_canceled)))));
+                }
+                m_pendingReadTextureRequests.clear();
+
+                while (!m_readTextureRequests.empty())
+                {
+                    auto error = arcana::make_unexpected(std::make_exception_ptr(std::system_error(std::make_error_code(std::errc::operation_canceled))));
+                    m_readTextureRequests.front().second.complete(error);
+                    m_readTextureRequests.pop();
+                }
             }
 
             // HACK: Render one more frame to drain the before/after render work queues.
@@ -202,8 +347,24 @@ namespace Babylon::Graphics
 
             m_cancellationSource->cancel();
 
-            bgfx::shutdown();
+            DestroyRenderTargets();
+            for (const auto& texture : m_readBackTextures)
+            {
+                bgfx::destroy(texture.Handle);
+            }
+            m_readBackTextures.clear();
+
+            if (bgfx::isValid(m_upscale.Program))
+            {
+                bgfx::destroy(m_upscale.Program);
+                bgfx::destroy(m_upscale.Sampler);
+                m_upscale.Program = BGFX_INVALID_HANDLE;
+                m_upscale.Sampler = BGFX_INVALID_HANDLE;
+            }
+
+            BgfxContext::Get().Detach(*this);
             m_state.Bgfx.Initialized = false;
+            m_state.Bgfx.OwnsBackBuffer = false;
             m_bgfxId++;
 
             m_renderThreadAffinity = {};
@@ -248,6 +409,9 @@ namespace Babylon::Graphics
         // Update bgfx state if necessary.
         UpdateBgfxState();
 
+        // Recording from here on is submitted with the next frame of the shared bgfx context.
+        BgfxContext::Get().BeginFrame(*this);
+
         // Unlock the update safe timespans.
         {
             std::scoped_lock lock{m_updateSafeTimespansMutex};
@@ -280,8 +444,17 @@ namespace Babylon::Graphics
 
         m_beforeRenderDispatcher.tick(*m_cancellationSource);
 
+        if (m_framePacing.FrameStart != std::chrono::steady_clock::time_point{})
+        {
+            m_framePacing.SmoothedWorkTime = Smooth(m_framePacing.SmoothedWorkTime, ToMilliseconds(std::chrono::steady_clock::now() - m_framePacing.FrameStart));
+        }
+
         Frame();
 
+        m_framePacing.LastPresent = std::chrono::steady_clock::now();
+
+        UpdateDynamicResolution();
+
         m_afterRenderDispatcher.tick(*m_cancellationSource);
 
         m_rendering = false;
@@ -314,6 +487,150 @@ namespace Babylon::Graphics
         return m_state.Resolution.DevicePixelRatio;
     }
 
+    void DeviceImpl::SetDynamicResolution(const DynamicResolutionConfiguration& config)
+    {
+        if (config.TargetFrameTime < 0.0f || config.MinScale <= 0.0f || config.MinScale > config.MaxScale)
+        {
+            throw std::runtime_error{"Invalid dynamic resolution configuration."};
+        }
+
+        std::scoped_lock lock{m_state.Mutex};
+        m_dynamicResolution.Config = config;
+        m_dynamicResolution.SmoothedFrameTime = 0.0f;
+        m_dynamicResolution.FramesSinceChange = 0;
+
+        // The scaled render target follows the scale at the start of the next frame.
+        m_state.Resolution.RenderScale = config.TargetFrameTime > 0.0f ? std::clamp(m_state.Resolution.RenderScale, config.MinScale, config.MaxScale) : 1.0f;
+    }
+
+    float DeviceImpl::GetRenderScale() const
+    {
+        std::scoped_lock lock{m_state.Mutex};
+        return m_state.Resolution.RenderScale;
+    }
+
+    float DeviceImpl::GetRenderScalingLevel() const
+    {
+        std::scoped_lock lock{m_state.Mutex};
+        return m_state.Resolution.HardwareScalingLevel / m_state.Resolution.RenderScale;
+    }
+
+    void DeviceImpl::SetFramePacing(const FramePacingConfiguration& config)
+    {
+        if (config.TargetFrameRate < 0.0f)
+        {
+            throw std::runtime_error{"Target frame rate cannot be negative."};
+        }
+
+        {
+            std::scoped_lock lock{m_framePacing.Mutex};
+            m_framePacing.Config = config;
+        }
+
+        std::scoped_lock lock{m_state.Mutex};
+        auto& reset = m_state.Bgfx.InitState.resolution.reset;
+        const uint32_t vsync{config.VSync ? BGFX_RESET_VSYNC : 0u};
+        if ((reset & BGFX_RESET_VSYNC) != vsync)
+        {
+            reset = (reset & ~BGFX_RESET_VSYNC) | vsync;
+            m_state.Bgfx.Dirty = true;
+        }
+    }
+
+    void DeviceImpl::WaitForFrameStart()
+    {
+        FramePacingConfiguration config{};
+        {
+            std::scoped_lock lock{m_framePacing.Mutex};
+            config = m_framePacing.Config;
+        }
+
+        using clock = std::chrono::steady_clock;
+        auto& pacing = m_framePacing;
+        const bool hasPreviousFrame{pacing.FrameStart != clock::time_point{}};
+
+        if (hasPreviousFrame)
+        {
+            const auto targetFrameTime{config.TargetFrameRate > 0.0f
+                ? std::chrono::duration_cast<clock::duration>(std::chrono::duration<float>(1.0f / config.TargetFrameRate))
+                : clock::duration{}};
+
+            auto start{pacing.FrameStart + targetFrameTime};
+
+            // The next deadline is one frame after the last present, either at the target rate or the measured rate.
+            if (config.LateLatch && pacing.LastPresent != clock::time_point{})
+            {
+                const auto frameTime{targetFrameTime != clock::duration{}
+                    ? targetFrameTime
+                    : std::chrono::duration_cast<clock::duration>(std::chrono::duration<float, std::milli>(pacing.SmoothedFrameTime))};
+                const auto workTime{std::chrono::duration_cast<clock::duration>(std::chrono::duration<float, std::milli>(pacing.SmoothedWorkTime))};
+                start = std::max(start, pacing.LastPresent + frameTime - workTime - FRAME_PACING_LATE_LATCH_MARGIN);
+            }
+
+            WaitUntil(start);
+        }
+
+        const auto now{clock::now()};
+        if (hasPreviousFrame)
+        {
+            pacing.FrameTime = ToMilliseconds(now - pacing.FrameStart);
+            const float expectedFrameTime{config.TargetFrameRate > 0.0f ? 1000.0f / config.TargetFrameRate : pacing.SmoothedFrameTime};
+            pacing.Jitter = Smooth(pacing.Jitter, std::abs(pacing.FrameTime - (expectedFrameTime == 0.0f ? pacing.FrameTime : expectedFrameTime)));
+            pacing.SmoothedFrameTime = Smooth(pacing.SmoothedFrameTime, pacing.FrameTime);
+        }
+
+        pacing.FrameStart = now;
+    }
+
+    void DeviceImpl::UpdateDynamicResolution()
+    {
+        std::scoped_lock lock{m_state.Mutex};
+        auto& controller = m_dynamicResolution;
+        if (controller.Config.TargetFrameTime <= 0.0f)
+        {
+            return;
+        }
+
+        // Use the time spent rendering rather than the time between frames, which is bound by vsync.
+        const bgfx::Stats* stats{bgfx::getStats()};
+        double frameTime{stats->cpuTimerFreq > 0 ? (stats->cpuTimeEnd - stats->cpuTimeBegin) * 1000.0 / stats->cpuTimerFreq : 0.0};
+        if (stats->gpuTimerFreq > 0 && stats->gpuTimeEnd > stats->gpuTimeBegin)
+        {
+            frameTime = std::max(frameTime, (stats->gpuTimeEnd - stats->gpuTimeBegin) * 1000.0 / stats->gpuTimerFreq);
+        }
+
+        controller.SmoothedFrameTime = controller.SmoothedFrameTime == 0.0f
+            ? static_cast<float>(frameTime)
+            : controller.SmoothedFrameTime + (static_cast<float>(frameTime) - controller.SmoothedFrameTime) * DYNAMIC_RESOLUTION_SMOOTHING;
+
+        if (++controller.FramesSinceChange < DYNAMIC_RESOLUTION_MIN_FRAMES_BETWEEN_CHANGES || controller.SmoothedFrameTime <= 0.0f)
+        {
+            return;
+        }
+
+        const float target{controller.Config.TargetFrameTime};
+        const float smoothed{controller.SmoothedFrameTime};
+        if (smoothed <= target && smoothed >= target * DYNAMIC_RESOLUTION_HEADROOM)
+        {
+            return;
+        }
+
+        // Render time scales with the pixel count, which is the square of the scale.
+        const float currentScale{m_state.Resolution.RenderScale};
+        float scale{currentScale * std::sqrt(target / smoothed)};
+        scale = std::round(scale / DYNAMIC_RESOLUTION_STEP) * DYNAMIC_RESOLUTION_STEP;
+        scale = std::clamp(scale, controller.Config.MinScale, controller.Config.MaxScale);
+        if (std::abs(scale - currentScale) < DYNAMIC_RESOLUTION_STEP * 0.5f)
+        {
+            return;
+        }
+
+        // Applied by resizing the scaled render target at the start of the next frame.
+        m_state.Resolution.RenderScale = scale;
+        controller.FramesSinceChange = 0;
+        controller.SmoothedFrameTime = 0.0f;
+    }
+
     continuation_scheduler<>& DeviceImpl::BeforeRenderScheduler()
     {
         return m_beforeRenderDispatcher.scheduler();
@@ -326,16 +643,37 @@ namespace Babylon::Graphics
 
     void DeviceImpl::RequestScreenShot(std::function<void(std::vector<uint8_t>)> callback)
     {
+        {
+            std::scoped_lock lock{m_state.Mutex};
+            if (m_state.Bgfx.Initialized && !m_state.Bgfx.OwnsBackBuffer)
+            {
+                throw std::runtime_error{"Screen shots are only available on the device that owns the back buffer."};
+            }
+        }
+
         m_screenShotCallbacks.push(std::move(callback));
     }
 
     arcana::task<void, std::exception_ptr> DeviceImpl::ReadTextureAsync(bgfx::TextureHandle handle, gsl::span<uint8_t> data, uint8_t mipLevel)
     {
         arcana::task_completion_source<void, std::exception_ptr> completionSource{};
-        m_readTextureRequests.emplace(bgfx::readTexture(handle, data.data(), mipLevel), completionSource);
+        std::scoped_lock lock{m_readTextureRequestsMutex};
+        m_pendingReadTextureRequests.push_back({handle, data, mipLevel, completionSource});
         return completionSource.as_task();
     }
 
+    void DeviceImpl::RequestReadTextures()
+    {
+        // bgfx has no encoder variant of readTexture, so reads are issued on the render thread with the rest of the frame.
+        std::scoped_lock lock{m_readTextureRequestsMutex};
+        for (auto& request : m_pendingReadTextureRequests)
+        {
+            m_readTextureRequests.emplace(bgfx::readTexture(request.Handle, request.Data.data(), request.MipLevel), std::move(request.CompletionSource));
+        }
+
+        m_pendingReadTextureRequests.clear();
+    }
+
     DeviceImpl::CaptureCallbackTicketT DeviceImpl::AddCaptureCallback(std::function<void(const BgfxCallback::CaptureData&)> callback)
     {
         // If we're not already capturing, start.
@@ -353,17 +691,75 @@ namespace Babylon::Graphics
 
     bgfx::ViewId DeviceImpl::AcquireNewViewId(bgfx::Encoder&)
     {
-        bgfx::ViewId viewId = m_nextViewId.fetch_add(1);
-        if (viewId >= bgfx::getCaps()->limits.maxViews)
+        return AcquireViewId();
+    }
+
+    bgfx::ViewId DeviceImpl::AcquireViewId()
+    {
+        // Views come from the range of the device, so that devices never share a view. The blit view is never handed out.
+        const uint32_t viewIndex{m_viewCount.fetch_add(1)};
+        if (viewIndex >= m_viewIdCount)
         {
-            throw std::runtime_error{"Too many views"};
+            m_viewsOverflowed.fetch_add(1);
+
+            // Keep rendering into the last view rather than failing the frame. Its state is overwritten, so warn once per frame.
+            if (viewIndex == m_viewIdCount)
+            {
+                m_bgfxCallback.trace(__FILE__, __LINE__, "WARNING: Out of views (%u), rendering may be incorrect.", static_cast<uint32_t>(m_viewIdCount));
+            }
+
+            return static_cast<bgfx::ViewId>(m_firstViewId + m_viewIdCount - 1);
         }
-        return viewId;
+
+        return static_cast<bgfx::ViewId>(m_firstViewId + viewIndex);
+    }
+
+    void DeviceImpl::ResetViews()
+    {
+        m_viewCount.store(0);
+        m_viewsOverflowed.store(0);
+    }
+
+    bool DeviceImpl::IsLastViewId(bgfx::ViewId viewId) const
+    {
+        const uint32_t viewCount{std::min<uint32_t>(m_viewCount.load(), m_viewIdCount)};
+        return viewCount != 0 && viewId == m_firstViewId + viewCount - 1;
     }
 
     void DeviceImpl::UpdateBgfxState()
     {
         std::scoped_lock lock{m_state.Mutex};
+
+        UpdateBackBufferSize();
+        UpdateFrameSize();
+
+        // Only the device that owns the shared bgfx context has a back buffer, the others render offscreen. A device that
+        // takes over the context resets the back buffer with its own platform data.
+        const bool owner{BgfxContext::Get().IsOwner(*this)};
+        if (owner && !m_state.Bgfx.OwnsBackBuffer)
+        {
+            m_state.Bgfx.OwnsBackBuffer = true;
+            m_state.Bgfx.Dirty = true;
+        }
+
+        UpdateRenderTargets();
+
+        if (!owner)
+        {
+            m_state.Bgfx.Dirty = false;
+            return;
+        }
+
+        if (m_captureStopRequested.exchange(false))
+        {
+            std::scoped_lock callbackLock{m_captureCallbacksMutex};
+            if (m_captureCallbacks.empty())
+            {
+                m_state.Bgfx.Dirty = true;
+                m_state.Bgfx.InitState.resolution.reset &= ~BGFX_RESET_CAPTURE;
+            }
+        }
+
         if (m_state.Bgfx.Dirty)
         {
             bgfx::setPlatformData(m_state.Bgfx.InitState.platformData);
@@ -373,8 +769,8 @@ namespace Babylon::Graphics
 
             auto& res = m_state.Bgfx.InitState.resolution;
             bgfx::reset(res.width, res.height, res.reset);
-            bgfx::setViewRect(0, 0, 0, static_cast<uint16_t>(res.width), static_cast<uint16_t>(res.height));
-            bgfx::frame();
+            bgfx::setViewRect(m_firstViewId, 0, 0, static_cast<uint16_t>(res.width), static_cast<uint16_t>(res.height));
+            BgfxContext::Get().Frame(*this);
 
             m_state.Bgfx.Dirty = false;
         }
@@ -384,10 +780,311 @@ namespace Babylon::Graphics
     {
         std::scoped_lock lock{m_state.Mutex};
         m_state.Bgfx.Dirty = true;
+
+        // The render scale only applies to the scaled render target.
         auto& res = m_state.Bgfx.InitState.resolution;
-        auto level = m_state.Resolution.HardwareScalingLevel;
-        res.width = static_cast<uint32_t>(m_state.Resolution.Width / level);
-        res.height = static_cast<uint32_t>(m_state.Resolution.Height / level);
+        const auto level{m_state.Resolution.HardwareScalingLevel};
+        res.width = static_cast<uint32_t>(m_state.Resolution.BackBufferWidth / level);
+        res.height = static_cast<uint32_t>(m_state.Resolution.BackBufferHeight / level);
+    }
+
+    void DeviceImpl::UpdateBackBufferSize()
+    {
+        std::scoped_lock lock{m_state.Mutex};
+        auto& resolution = m_state.Resolution;
+        if (!resolution.ResizePending)
+        {
+            return;
+        }
+
+        if (resolution.Width == resolution.BackBufferWidth && resolution.Height == resolution.BackBufferHeight)
+        {
+            resolution.ResizePending = false;
+            return;
+        }
+
+        const auto exceedsThreshold = [threshold{m_backBufferResizeThreshold}](size_t size, size_t backBufferSize) {
+            return std::abs(static_cast<float>(size) - static_cast<float>(backBufferSize)) > threshold * backBufferSize;
+        };
+
+        // The live size is rendered into the scaled target while a resize settles, which can only be scaled down to fill
+        // the back buffer, so the back buffer has to be reset as soon as it no longer fits.
+        const bool grown{resolution.Width > resolution.BackBufferWidth || resolution.Height > resolution.BackBufferHeight};
+        const bool settled{m_frameNumber.load() - resolution.ResizeFrameNumber >= BACK_BUFFER_RESIZE_SETTLE_FRAMES};
+        if (m_backBufferResizeThreshold <= 0.0f || !m_state.Bgfx.Initialized || settled)
+        {
+            resolution.BackBufferWidth = resolution.Width;
+            resolution.BackBufferHeight = resolution.Height;
+            resolution.ResizePending = false;
+        }
+        else if (grown || exceedsThreshold(resolution.Width, resolution.BackBufferWidth) || exceedsThreshold(resolution.Height, resolution.BackBufferHeight))
+        {
+            // Over-allocate while growing so that the rest of the resize fits without another reset.
+            const float growth{grown ? 1.0f + m_backBufferResizeThreshold : 1.0f};
+            resolution.BackBufferWidth = static_cast<size_t>(resolution.Width * growth);
+            resolution.BackBufferHeight = static_cast<size_t>(resolution.Height * growth);
+        }
+        else
+        {
+            return;
+        }
+
+        UpdateBgfxResolution();
+    }
+
+    void DeviceImpl::UpdateFrameSize()
+    {
+        // Views are sized by the live size, which can't exceed the back buffer before the next reset applies a resize.
+        std::scoped_lock lock{m_state.Mutex};
+        m_frameWidth.store(std::min(m_state.Resolution.Width, m_state.Resolution.BackBufferWidth));
+        m_frameHeight.store(std::min(m_state.Resolution.Height, m_state.Resolution.BackBufferHeight));
+    }
+
+    bgfx::FrameBufferHandle DeviceImpl::GetBackBufferHandle() const
+    {
+        std::scoped_lock lock{m_state.Mutex};
+        return bgfx::isValid(m_state.Scaled.FrameBuffer) ? m_state.Scaled.FrameBuffer : m_state.Offscreen.FrameBuffer;
+    }
+
+    void DeviceImpl::ResizeRenderTarget(RenderTarget& target, uint16_t width, uint16_t height, uint64_t msaaFlags)
+    {
+        if (bgfx::isValid(target.FrameBuffer) && target.Width == width && target.Height == height && target.MSAAFlags == msaaFlags)
+        {
+            return;
+        }
+
+        DestroyRenderTarget(target);
+
+        // bgfx resolves the multisampled color texture when it is sampled, the depth is never read back.
+        target.Color = bgfx::createTexture2D(width, height, false, 1, bgfx::TextureFormat::RGBA8, msaaFlags);
+        const bgfx::TextureHandle attachments[]{
+            target.Color,
+            bgfx::createTexture2D(width, height, false, 1, bgfx::TextureFormat::D24S8, msaaFlags | BGFX_TEXTURE_RT_WRITE_ONLY),
+        };
+        target.FrameBuffer = bgfx::createFrameBuffer(2, attachments, true);
+        target.Width = width;
+        target.Height = height;
+        target.MSAAFlags = msaaFlags;
+    }
+
+    void DeviceImpl::DestroyRenderTarget(RenderTarget& target)
+    {
+        if (bgfx::isValid(target.FrameBuffer))
+        {
+            // The framebuffer owns its textures.
+            bgfx::destroy(target.FrameBuffer);
+        }
+
+        target = {};
+    }
+
+    void DeviceImpl::UpdateRenderTargets()
+    {
+        std::scoped_lock lock{m_state.Mutex};
+
+        // A device that doesn't own the back buffer of the shared bgfx context renders offscreen even with a window. The
+        // offscreen target isn't multisampled, since read backs blit from it.
+        const auto& res = m_state.Bgfx.InitState.resolution;
+        if (m_offscreen || !m_state.Bgfx.OwnsBackBuffer)
+        {
+            ResizeRenderTarget(m_state.Offscreen, static_cast<uint16_t>(std::max(res.width, 1u)), static_cast<uint16_t>(std::max(res.height, 1u)), BGFX_TEXTURE_RT);
+        }
+        else
+        {
+            DestroyRenderTarget(m_state.Offscreen);
+        }
+
+        // A back buffer larger than the requested size is only presented filled with the scaled target.
+        const auto& resolution = m_state.Resolution;
+        const bool settling{GetWidth() != resolution.BackBufferWidth || GetHeight() != resolution.BackBufferHeight};
+        if (resolution.RenderScale == 1.0f && !settling)
+        {
+            DestroyRenderTarget(m_state.Scaled);
+            return;
+        }
+
+        // Multisampled like the back buffer it replaces. The MSAA reset flags and the render target texture flags count
+        // samples the same way, from no multisampling up.
+        const uint64_t msaaFlags{(((res.reset & BGFX_RESET_MSAA_MASK) >> BGFX_RESET_MSAA_SHIFT) + 1) << BGFX_TEXTURE_RT_MSAA_SHIFT};
+
+        // Sized like the views rendering into it, see FrameBuffer::Width.
+        const float level{GetRenderScalingLevel()};
+        const auto width{static_cast<uint16_t>(std::max(GetWidth() / level, 1.0f))};
+        const auto height{static_cast<uint16_t>(std::max(GetHeight() / level, 1.0f))};
+        ResizeRenderTarget(m_state.Scaled, width, height, msaaFlags);
+    }
+
+    void DeviceImpl::DestroyRenderTargets()
+    {
+        std::scoped_lock lock{m_state.Mutex};
+        DestroyRenderTarget(m_state.Offscreen);
+        DestroyRenderTarget(m_state.Scaled);
+    }
+
+    void DeviceImpl::UpscaleScaledTarget(bgfx::Encoder& encoder)
+    {
+        bgfx::TextureHandle color{};
+        bgfx::FrameBufferHandle destination{};
+        float width{};
+        float height{};
+        {
+            std::scoped_lock lock{m_state.Mutex};
+            if (!bgfx::isValid(m_state.Scaled.FrameBuffer))
+            {
+                return;
+            }
+
+            // Fills the whole back buffer, which is larger than the requested size while a resize settles.
+            color = m_state.Scaled.Color;
+            destination = m_state.Offscreen.FrameBuffer;
+            width = static_cast<float>(m_state.Bgfx.InitState.resolution.width);
+            height = static_cast<float>(m_state.Bgfx.InitState.resolution.height);
+        }
+
+        if (!bgfx::isValid(m_upscale.Program))
+        {
+            const bgfx::RendererType::Enum type{bgfx::getRendererType()};
+            m_upscale.Program = bgfx::createProgram(
+                bgfx::createEmbeddedShader(s_embeddedShaders, type, "vs_ocornut_imgui"),
+                bgfx::createEmbeddedShader(s_embeddedShaders, type, "fs_ocornut_imgui"),
+                true);
+            m_upscale.Sampler = bgfx::createUniform("s_tex", bgfx::UniformType::Sampler);
+            m_upscale.Layout.begin()
+                .add(bgfx::Attrib::Position, 2, bgfx::AttribType::Float)
+                .add(bgfx::Attrib::TexCoord0, 2, bgfx::AttribType::Float)
+                .add(bgfx::Attrib::Color0, 4, bgfx::AttribType::Uint8, true)
+                .end();
+        }
+
+        if (bgfx::getAvailTransientVertexBuffer(3, m_upscale.Layout) < 3)
+        {
+            return;
+        }
+
+        // One triangle covering the view. Render targets are stored bottom up when the origin is at the bottom left.
+        const bool flip{bgfx::getCaps()->originBottomLeft};
+        bgfx::TransientVertexBuffer vertexBuffer{};
+        bgfx::allocTransientVertexBuffer(&vertexBuffer, 3, m_upscale.Layout);
+        auto* vertices{reinterpret_cast<UpscaleVertex*>(vertexBuffer.data)};
+        vertices[0] = {0.0f, 0.0f, 0.0f, flip ? 1.0f : 0.0f, 0xffffffff};
+        vertices[1] = {width * 2.0f, 0.0f, 2.0f, flip ? 1.0f : 0.0f, 0xffffffff};
+        vertices[2] = {0.0f, height * 2.0f, 0.0f, flip ? -1.0f : 2.0f, 0xffffffff};
+
+        // After all the views that rendered the scene.
+        const bgfx::ViewId viewId{AcquireViewId()};
+        float projection[16];
+        bx::mtxOrtho(projection, 0.0f, width, height, 0.0f, 0.0f, 1.0f, 0.0f, bgfx::getCaps()->homogeneousDepth);
+        bgfx::setViewFrameBuffer(viewId, destination);
+        bgfx::setViewRect(viewId, 0, 0, static_cast<uint16_t>(width), static_cast<uint16_t>(height));
+        bgfx::setViewClear(viewId, BGFX_CLEAR_NONE);
+        bgfx::setViewTransform(viewId, nullptr, projection);
+
+        encoder.setVertexBuffer(0, &vertexBuffer);
+        encoder.setTexture(0, m_upscale.Sampler, color, BGFX_SAMPLER_U_CLAMP | BGFX_SAMPLER_V_CLAMP);
+        encoder.setState(BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A);
+        encoder.submit(viewId, m_upscale.Program);
+    }
+
+    arcana::task<ReadBackImage, std::exception_ptr> DeviceImpl::ReadBackAsync()
+    {
+        if (!m_offscreen)
+        {
+            throw std::runtime_error{"Read back is only available on offscreen devices."};
+        }
+
+        arcana::task_completion_source<ReadBackImage, std::exception_ptr> completionSource{};
+        std::scoped_lock lock{m_readBackRequestsMutex};
+        m_readBackRequests.push_back(completionSource);
+        return completionSource.as_task();
+    }
+
+    void DeviceImpl::RequestReadBacks(bgfx::Encoder& encoder)
+    {
+        std::vector<arcana::task_completion_source<ReadBackImage, std::exception_ptr>> requests{};
+        {
+            std::scoped_lock lock{m_readBackRequestsMutex};
+            requests.swap(m_readBackRequests);
+        }
+
+        if (requests.empty())
+        {
+            return;
+        }
+
+        bgfx::TextureHandle color{};
+        uint16_t width{};
+        uint16_t height{};
+        {
+            std::scoped_lock lock{m_state.Mutex};
+            color = m_state.Offscreen.Color;
+            width = m_state.Offscreen.Width;
+            height = m_state.Offscreen.Height;
+        }
+
+        // Render targets can't be read directly, so all the requests of this frame share one copy into a read back texture.
+        // The copy is in a view after all the views of the frame.
+        const ReadBackTexture readBackTexture{AcquireReadBackTexture(width, height)};
+        encoder.blit(AcquireViewId(), readBackTexture.Handle, 0, 0, color);
+
+        // The read completes on the render thread, either in a later frame or when rendering is disabled.
+        auto pixels{std::make_shared<std::vector<uint8_t>>(static_cast<size_t>(width) * height * 4)};
+        ReadTextureAsync(readBackTexture.Handle, *pixels, 0)
+            .then(arcana::inline_scheduler, arcana::cancellation::none(), [this, readBackTexture, pixels, width, height, requests{std::move(requests)}](const arcana::expected<void, std::exception_ptr>& result) mutable {
+                ReleaseReadBackTexture(readBackTexture);
+
+                if (result.has_error())
+                {
+                    for (auto& request : requests)
+                    {
+                        request.complete(arcana::make_unexpected(result.error()));
+                    }
+                    return;
+                }
+
+                ReadBackImage image{width, height, {}};
+                if (bgfx::getCaps()->originBottomLeft)
+                {
+                    image.Pixels.resize(pixels->size());
+                    CopyPixels32(pixels->data(), width * 4, image.Pixels.data(), width * 4, width, height, false, true);
+                }
+                else
+                {
+                    image.Pixels = std::move(*pixels);
+                }
+
+                for (size_t index = 0; index < requests.size(); ++index)
+                {
+                    requests[index].complete(index + 1 == requests.size() ? std::move(image) : image);
+                }
+            });
+    }
+
+    DeviceImpl::ReadBackTexture DeviceImpl::AcquireReadBackTexture(uint16_t width, uint16_t height)
+    {
+        const auto it{std::find_if(m_readBackTextures.begin(), m_readBackTextures.end(), [width, height](const ReadBackTexture& texture) {
+            return texture.Width == width && texture.Height == height;
+        })};
+
+        if (it != m_readBackTextures.end())
+        {
+            const ReadBackTexture texture{*it};
+            m_readBackTextures.erase(it);
+            return texture;
+        }
+
+        return {bgfx::createTexture2D(width, height, false, 1, bgfx::TextureFormat::RGBA8, BGFX_TEXTURE_BLIT_DST | BGFX_TEXTURE_READ_BACK), width, height};
+    }
+
+    void DeviceImpl::ReleaseReadBackTexture(const ReadBackTexture& texture)
+    {
+        m_readBackTextures.push_back(texture);
+
+        // Keep only the most recently used read back textures, which also drops the ones of a previous size.
+        if (m_readBackTextures.size() > MAX_IDLE_READ_BACK_TEXTURES)
+        {
+            bgfx::destroy(m_readBackTextures.front().Handle);
+            m_readBackTextures.erase(m_readBackTextures.begin());
+        }
     }
 
     void DeviceImpl::DiscardIfDirty()
@@ -408,7 +1105,7 @@ namespace Babylon::Graphics
 #if D3D12
             // D3D12 capture is immediate but needs an extra frame swap because back buffer is captured.
             // Because of previous swapchain flip, back buffer is not what's just been rendered.
-            bgfx::frame();
+            BgfxContext::Get().Frame(*this);
 #endif
             bgfx::requestScreenShot(BGFX_INVALID_HANDLE, "DeviceImpl::RequestScreenShot");
         }
@@ -424,20 +1121,77 @@ namespace Babylon::Graphics
         // Discard everything if the bgfx state is dirty.
         DiscardIfDirty();
 
-        // Request screen shots before bgfx::frame.
+        // The device records its own passes in its own encoder, so they never go through the encoder of another device.
+        // The scene is upscaled before it is read back or captured.
+        bgfx::Encoder* encoder{bgfx::begin(true)};
+        UpscaleScaledTarget(*encoder);
+        RequestReadBacks(*encoder);
+        bgfx::end(encoder);
+
+        // Request screen shots and texture reads before bgfx::frame.
         RequestScreenShots();
+        RequestReadTextures();
+
+        // The views are only reset once they were submitted, which can happen in another device's Frame.
+        UpdateFrameStats();
 
-        // Advance frame and render!
-        uint32_t frameNumber{bgfx::frame()};
+        // Advance frame and render! Only the owner of the bgfx context requests frames, the other devices are part of its next frame.
+        uint32_t frameNumber{BgfxContext::Get().Frame(*this)};
+        m_frameNumber.fetch_add(1);
 
-        // Process read texture requests.
-        while (!m_readTextureRequests.empty() && m_readTextureRequests.front().first <= frameNumber)
+        // Process read texture requests. Completion runs continuations, so complete them outside of the lock.
+        std::vector<arcana::task_completion_source<void, std::exception_ptr>> completedReadTextureRequests{};
         {
-            m_readTextureRequests.front().second.complete();
-            m_readTextureRequests.pop();
+            std::scoped_lock lock{m_readTextureRequestsMutex};
+            while (!m_readTextureRequests.empty() && m_readTextureRequests.front().first <= frameNumber)
+            {
+                completedReadTextureRequests.push_back(std::move(m_readTextureRequests.front().second));
+                m_readTextureRequests.pop();
+            }
         }
 
-        m_nextViewId.store(0);
+        for (auto& completionSource : completedReadTextureRequests)
+        {
+            completionSource.complete();
+        }
+    }
+
+    FrameStats DeviceImpl::GetFrameStats() const
+    {
+        std::scoped_lock lock{m_frameStatsMutex};
+        return m_frameStats;
+    }
+
+    void DeviceImpl::AddTextureUploadStats(uint64_t uploadedBytes, uint64_t savedBytes)
+    {
+        m_frameStatsCounters.TextureBytesUploaded += uploadedBytes;
+        m_frameStatsCounters.TextureBytesSaved += savedBytes;
+    }
+
+    void DeviceImpl::AddCanvasStats(const CanvasStats& stats)
+    {
+        m_frameStatsCounters.CanvasDrawCalls += stats.DrawCalls;
+        m_frameStatsCounters.CanvasUnbatchedDrawCalls += stats.UnbatchedDrawCalls;
+        m_frameStatsCounters.CanvasVertices += stats.Vertices;
+        m_frameStatsCounters.CanvasTransientOverflows += stats.TransientOverflows;
+    }
+
+    void DeviceImpl::UpdateFrameStats()
+    {
+        std::scoped_lock lock{m_frameStatsMutex};
+        m_frameStats.TextureBytesUploaded = m_frameStatsCounters.TextureBytesUploaded.exchange(0);
+        m_frameStats.TextureBytesSaved = m_frameStatsCounters.TextureBytesSaved.exchange(0);
+        m_frameStats.CanvasDrawCalls = m_frameStatsCounters.CanvasDrawCalls.exchange(0);
+        m_frameStats.CanvasUnbatchedDrawCalls = m_frameStatsCounters.CanvasUnbatchedDrawCalls.exchange(0);
+        m_frameStats.CanvasVertices = m_frameStatsCounters.CanvasVertices.exchange(0);
+        m_frameStats.CanvasTransientOverflows = m_frameStatsCounters.CanvasTransientOverflows.exchange(0);
+
+        const uint32_t viewsOverflowed{m_viewsOverflowed.load()};
+        m_frameStats.ViewsUsed = m_viewCount.load() - viewsOverflowed;
+        m_frameStats.ViewsOverflowed = viewsOverflowed;
+
+        m_frameStats.FrameTime = m_framePacing.FrameTime;
+        m_frameStats.FrameTimeJitter = m_framePacing.Jitter;
     }
 
     bgfx::Encoder* DeviceImpl::GetEncoderForThread()
@@ -472,12 +1226,11 @@ namespace Babylon::Graphics
     {
         std::scoped_lock callbackLock{m_captureCallbacksMutex};
 
-        // If no one is listening anymore, stop capturing.
+        // If no one is listening anymore, stop capturing. This may run on the bgfx render thread while the state is locked
+        // around bgfx::frame, so the reset is applied by the next UpdateBgfxState instead.
         if (m_captureCallbacks.empty())
         {
-            std::scoped_lock stateLock{m_state.Mutex};
-            m_state.Bgfx.Dirty = true;
-            m_state.Bgfx.InitState.resolution.reset &= ~BGFX_RESET_CAPTURE;
+            m_captureStopRequested.store(true);
             return;
         }
 
@@ -17,6 +17,7 @@
 #include <bgfx/bgfx.h>
 #include <bgfx/platform.h>
 
+#include <chrono>
 #include <memory>
 #include <map>
 #include <optional>
@@ -46,7 +47,9 @@ namespace Babylon::Graphics
         void UpdateMSAA(uint8_t value);
         void UpdateAlphaPremultiplied(bool enabled);
         void UpdateDevicePixelRatio(float value);
+        void UpdateDisplayMetrics();
         void SetRenderResetCallback(std::function<void()> callback);
+        void SetDevicePixelRatioChangedCallback(std::function<void(float)> callback);
 
         void AddToJavaScript(Napi::Env);
         static DeviceImpl& GetFromJavaScript(Napi::Env);
@@ -68,16 +71,31 @@ namespace Babylon::Graphics
 
         float GetDevicePixelRatio() const;
 
+        void SetDynamicResolution(const DynamicResolutionConfiguration& config);
+        float GetRenderScale() const;
+
+        // The hardware scaling level combined with the dynamic resolution scale.
+        float GetRenderScalingLevel() const;
+
+        void SetFramePacing(const FramePacingConfiguration& config);
+
+        // Blocks until the frame should start according to the frame pacing configuration.
+        void WaitForFrameStart();
+
         PlatformInfo GetPlatformInfo() const;
 
         uintptr_t GetId() const;
 
+        arcana::task<ReadBackImage, std::exception_ptr> ReadBackAsync();
+
         /* ********** END DEVICE CONTRACT ********** */
 
         /* ********** BEGIN DEVICE CONTEXT CONTRACT ********** */
 
-        size_t GetWidth() const { return m_state.Resolution.Width; }
-        size_t GetHeight() const { return m_state.Resolution.Height; }
+        // The requested size as of the start of the frame. While a resize settles it is rendered into the scaled target,
+        // which fills the back buffer.
+        size_t GetWidth() const { return m_frameWidth.load(); }
+        size_t GetHeight() const { return m_frameHeight.load(); }
 
         continuation_scheduler<>& BeforeRenderScheduler();
         continuation_scheduler<>& AfterRenderScheduler();
@@ -90,6 +108,22 @@ namespace Babylon::Graphics
         CaptureCallbackTicketT AddCaptureCallback(std::function<void(const BgfxCallback::CaptureData&)> callback);
 
         bgfx::ViewId AcquireNewViewId(bgfx::Encoder&);
+        bool IsLastViewId(bgfx::ViewId viewId) const;
+
+        uint32_t GetFrameNumber() const { return m_frameNumber.load(); }
+
+        bool IsMultithreaded() const { return m_multithreaded; }
+
+        // The framebuffer the scene renders into: the scaled target, the target of an offscreen device, or the invalid
+        // handle for the back buffer.
+        bgfx::FrameBufferHandle GetBackBufferHandle() const;
+
+        size_t GetTextureMemoryBudget() const { return m_textureMemoryBudget.load(); }
+        void SetTextureMemoryBudget(size_t bytes) { m_textureMemoryBudget.store(bytes); }
+
+        FrameStats GetFrameStats() const;
+        void AddTextureUploadStats(uint64_t uploadedBytes, uint64_t savedBytes);
+        void AddCanvasStats(const CanvasStats& stats);
 
         /* ********** END DEVICE CONTEXT CONTRACT ********** */
 
@@ -101,55 +135,182 @@ namespace Babylon::Graphics
 
     private:
         friend class UpdateToken;
+        friend class BgfxContext;
 
         static const bgfx::RendererType::Enum s_bgfxRenderType;
         static void ConfigureBgfxPlatformData(bgfx::PlatformData& pd, WindowT window);
         static void ConfigureBgfxRenderType(bgfx::PlatformData& pd, bgfx::RendererType::Enum& renderType);
         static float GetDevicePixelRatio(WindowT window);
+        static void InvalidateDisplayMetrics(WindowT window);
+        static void ReleaseDisplayMetrics(WindowT window);
 
         void UpdateBgfxState();
         void UpdateBgfxResolution();
+        void UpdateBackBufferSize();
+        void UpdateFrameSize();
+        void UpdateDynamicResolution();
+        void UpdateRenderTargets();
+        void DestroyRenderTargets();
+        void UpscaleScaledTarget(bgfx::Encoder& encoder);
         void DiscardIfDirty();
         void RequestScreenShots();
+        void RequestReadBacks(bgfx::Encoder& encoder);
+
+        struct ReadBackTexture
+        {
+            bgfx::TextureHandle Handle{BGFX_INVALID_HANDLE};
+            uint16_t Width{};
+            uint16_t Height{};
+        };
+
+        // Read back textures are pooled so that reading back every frame doesn't create textures. Only used on the render thread.
+        ReadBackTexture AcquireReadBackTexture(uint16_t width, uint16_t height);
+        void ReleaseReadBackTexture(const ReadBackTexture& texture);
+
+        void RequestReadTextures();
+        bgfx::ViewId AcquireViewId();
+
+        // Called by the shared bgfx context once the views recorded by the device were submitted.
+        void ResetViews();
+
         void Frame();
         bgfx::Encoder* GetEncoderForThread();
         void EndEncoders();
         void CaptureCallback(const BgfxCallback::CaptureData&);
+        void UpdateFrameStats();
+
+        struct RenderTarget
+        {
+            bgfx::FrameBufferHandle FrameBuffer{BGFX_INVALID_HANDLE};
+            bgfx::TextureHandle Color{BGFX_INVALID_HANDLE};
+            uint16_t Width{};
+            uint16_t Height{};
+            uint64_t MSAAFlags{};
+        };
+
+        // msaaFlags is one of the BGFX_TEXTURE_RT_MSAA_* flags, or BGFX_TEXTURE_RT without multisampling.
+        static void ResizeRenderTarget(RenderTarget& target, uint16_t width, uint16_t height, uint64_t msaaFlags);
+        static void DestroyRenderTarget(RenderTarget& target);
 
         arcana::affinity m_renderThreadAffinity{};
         bool m_rendering{};
+        const bool m_multithreaded{};
+        const bool m_offscreen{};
+        const float m_backBufferResizeThreshold{};
+
+        // The size views render at, updated at the start of each frame so that they don't need the state lock.
+        std::atomic<size_t> m_frameWidth{0};
+        std::atomic<size_t> m_frameHeight{0};
+
+        // Views of the device in the shared bgfx context, set when rendering is enabled.
+        bgfx::ViewId m_firstViewId{};
+        uint16_t m_viewIdCount{};
+
+        // Views acquired by this device since its views were last submitted, and how many of them were past its range.
+        std::atomic<uint32_t> m_viewCount{0};
+        std::atomic<uint32_t> m_viewsOverflowed{0};
 
-        std::atomic<bgfx::ViewId> m_nextViewId{0};
+        // Frames rendered by this device. Unlike the bgfx frame number, it keeps counting across device resets so
+        // that frame distances such as texture idle times never wrap.
+        std::atomic<uint32_t> m_frameNumber{0};
+        std::atomic<size_t> m_textureMemoryBudget{0};
+
+        // Counters for the frame being recorded, moved into m_frameStats when the frame is rendered.
+        struct
+        {
+            std::atomic<uint64_t> TextureBytesUploaded{};
+            std::atomic<uint64_t> TextureBytesSaved{};
+            std::atomic<uint32_t> CanvasDrawCalls{};
+            std::atomic<uint32_t> CanvasUnbatchedDrawCalls{};
+            std::atomic<uint32_t> CanvasVertices{};
+            std::atomic<uint32_t> CanvasTransientOverflows{};
+        } m_frameStatsCounters{};
+
+        FrameStats m_frameStats{};
+        mutable std::mutex m_frameStatsMutex{};
 
         std::optional<arcana::cancellation_source> m_cancellationSource{};
 
+        // Dynamic resolution controller state, guarded by the state mutex.
+        struct
+        {
+            DynamicResolutionConfiguration Config{};
+            float SmoothedFrameTime{};
+            uint32_t FramesSinceChange{};
+        } m_dynamicResolution{};
+
+        struct
+        {
+            std::mutex Mutex{};
+            FramePacingConfiguration Config{};
+
+            // Measurements, only used on the render thread.
+            std::chrono::steady_clock::time_point FrameStart{};
+            std::chrono::steady_clock::time_point LastPresent{};
+            float SmoothedFrameTime{};
+            float SmoothedWorkTime{};
+            float FrameTime{};
+            float Jitter{};
+        } m_framePacing{};
+
         struct
         {
             // Mutable since const getters need to lock.
             mutable std::recursive_mutex Mutex{};
 
+            WindowT NativeWindow{};
+
             struct
             {
                 bgfx::Init InitState{};
                 bool Initialized{};
                 bool Dirty{};
+
+                // Whether this device owns the bgfx context shared by the devices in the process.
+                bool OwnsBackBuffer{};
             } Bgfx{};
 
             struct
             {
+                // Requested size.
                 size_t Width{};
                 size_t Height{};
+
+                // Size the back buffer is allocated for, which can be larger than the requested size while a resize settles.
+                size_t BackBufferWidth{};
+                size_t BackBufferHeight{};
+                bool ResizePending{};
+                uint32_t ResizeFrameNumber{};
+
                 float HardwareScalingLevel{1.0f};
+                float RenderScale{1.0f};
                 float DevicePixelRatio{1.0f};
             } Resolution{};
+
+            // Render target of an offscreen device, sized like the back buffer would be.
+            RenderTarget Offscreen{};
+
+            // Render target of the scene while the render scale is not 1 or a resize settles, sized by the scale and the
+            // requested size. It is scaled to fill the back buffer at the end of the frame, so that scale changes never
+            // reset the back buffer and the stale parts of a larger back buffer are never presented.
+            RenderTarget Scaled{};
         } m_state;
 
+        // Program drawing the scaled target into the back buffer, created when first needed.
+        struct
+        {
+            bgfx::ProgramHandle Program{BGFX_INVALID_HANDLE};
+            bgfx::UniformHandle Sampler{BGFX_INVALID_HANDLE};
+            bgfx::VertexLayout Layout{};
+        } m_upscale{};
+
         BgfxCallback m_bgfxCallback;
 
         continuation_dispatcher<> m_beforeRenderDispatcher{};
         continuation_dispatcher<> m_afterRenderDispatcher{};
 
         std::mutex m_captureCallbacksMutex{};
+        std::atomic<bool> m_captureStopRequested{};
         arcana::ticketed_collection<std::function<void(const BgfxCallback::CaptureData&)>> m_captureCallbacks{};
 
         arcana::blocking_concurrent_queue<std::function<void(std::vector<uint8_t>)>> m_screenShotCallbacks{};
@@ -157,7 +318,21 @@ namespace Babylon::Graphics
         std::map<std::thread::id, bgfx::Encoder*> m_threadIdToEncoder{};
         std::mutex m_threadIdToEncoderMutex{};
 
+        // Read texture requests are made from the JavaScript thread, then issued and completed on the render thread.
+        struct ReadTextureRequest
+        {
+            bgfx::TextureHandle Handle;
+            gsl::span<uint8_t> Data;
+            uint8_t MipLevel;
+            arcana::task_completion_source<void, std::exception_ptr> CompletionSource;
+        };
+        std::vector<ReadTextureRequest> m_pendingReadTextureRequests{};
         std::queue<std::pair<uint32_t, arcana::task_completion_source<void, std::exception_ptr>>> m_readTextureRequests{};
+        std::mutex m_readTextureRequestsMutex{};
+
+        std::vector<arcana::task_completion_source<ReadBackImage, std::exception_ptr>> m_readBackRequests{};
+        std::mutex m_readBackRequestsMutex{};
+        std::vector<ReadBackTexture> m_readBackTextures{};
 
         std::map<std::string, SafeTimespanGuarantor> m_updateSafeTimespans{};
         std::mutex m_updateSafeTimespansMutex{};
@@ -165,5 +340,6 @@ namespace Babylon::Graphics
         DeviceContext m_context;
         uintptr_t m_bgfxId = 0;
         std::function<void()> m_renderResetCallback;
+        std::function<void(float)> m_devicePixelRatioChangedCallback;
     };
 }
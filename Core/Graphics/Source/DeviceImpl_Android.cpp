@@ -27,4 +27,13 @@ namespace Babylon::Graphics
         auto dpi = android::global::GetAppContext().getResources().getConfiguration().getDensityDpi();
         return static_cast<float>(dpi) / 160.0f;
     }
+
+    void DeviceImpl::InvalidateDisplayMetrics(WindowT)
+    {
+        // The pixel ratio is queried from the platform without caching.
+    }
+
+    void DeviceImpl::ReleaseDisplayMetrics(WindowT)
+    {
+    }
 }
@@ -1,6 +1,186 @@
 #include <Babylon/Graphics/Platform.h>
 #include "DeviceImpl.h"
 
+#ifdef BABYLON_NATIVE_XRANDR
+#include <X11/extensions/Xrandr.h>
+#endif
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+    // Opening a display is a round trip to the X server, so one connection is kept for the process and the metrics of each
+    // window are cached. XRandR notifies the connection of screen changes, which update its screen sizes in place. Without
+    // XRandR the connection never learns about them, so it is opened again when the metrics are invalidated.
+    class DisplayMetricsCache
+    {
+    public:
+        static DisplayMetricsCache& Get()
+        {
+            static DisplayMetricsCache cache{};
+            return cache;
+        }
+
+        float GetDevicePixelRatio(Window window)
+        {
+            std::scoped_lock lock{m_mutex};
+            ProcessScreenChanges();
+
+            auto it{m_metrics.find(window)};
+            if (it == m_metrics.end())
+            {
+                it = m_metrics.emplace(window, QueryMetrics(window)).first;
+            }
+
+            return it->second.DevicePixelRatio;
+        }
+
+        // Drops the metrics of the window if the screen configuration changed or the window is now on another screen.
+        void Invalidate(Window window)
+        {
+            std::scoped_lock lock{m_mutex};
+            ProcessScreenChanges();
+
+            if (m_randrEventBase < 0)
+            {
+                m_metrics.clear();
+                m_display.reset();
+                return;
+            }
+
+            const auto it{m_metrics.find(window)};
+            if (it != m_metrics.end() && m_display && it->second.Screen != GetScreen(window))
+            {
+                m_metrics.erase(it);
+            }
+        }
+
+        // Window ids are reused once a window is destroyed.
+        void Release(Window window)
+        {
+            std::scoped_lock lock{m_mutex};
+            m_metrics.erase(window);
+        }
+
+    private:
+        struct Metrics
+        {
+            int Screen{};
+            float DevicePixelRatio{1};
+        };
+
+        bool EnsureDisplay()
+        {
+            if (m_display)
+            {
+                return true;
+            }
+
+            m_display.reset(XOpenDisplay(nullptr));
+            if (!m_display)
+            {
+                return false;
+            }
+
+            m_randrEventBase = -1;
+#ifdef BABYLON_NATIVE_XRANDR
+            int errorBase{};
+            Display* display{m_display.get()};
+            if (XRRQueryExtension(display, &m_randrEventBase, &errorBase))
+            {
+                for (int screen = 0; screen < ScreenCount(display); ++screen)
+                {
+                    XRRSelectInput(display, RootWindow(display, screen), RRScreenChangeNotifyMask);
+                }
+            }
+            else
+            {
+                m_randrEventBase = -1;
+            }
+#endif
+
+            return true;
+        }
+
+        void ProcessScreenChanges()
+        {
+#ifdef BABYLON_NATIVE_XRANDR
+            if (!m_display || m_randrEventBase < 0)
+            {
+                return;
+            }
+
+            // Only XRandR events are selected on this connection.
+            Display* display{m_display.get()};
+            while (XPending(display) > 0)
+            {
+                XEvent event{};
+                XNextEvent(display, &event);
+                if (event.type == m_randrEventBase + RRScreenChangeNotify)
+                {
+                    XRRUpdateConfiguration(&event);
+                    m_metrics.clear();
+                }
+            }
+#endif
+        }
+
+        int GetScreen(Window window)
+        {
+            // Use the screen the window is on, falling back to the default screen.
+            Display* display{m_display.get()};
+            XWindowAttributes attributes{};
+            if (window != 0 && XGetWindowAttributes(display, window, &attributes) != 0 && attributes.screen != nullptr)
+            {
+                return XScreenNumberOfScreen(attributes.screen);
+            }
+
+            return DefaultScreen(display);
+        }
+
+        Metrics QueryMetrics(Window window)
+        {
+            if (!EnsureDisplay())
+            {
+                return {};
+            }
+
+            Display* display{m_display.get()};
+            const int screen{GetScreen(window)};
+            auto width = DisplayWidthMM(display, screen);
+            auto pixelWidth = DisplayWidth(display, screen);
+
+            if (width > 0)
+            {
+                constexpr float MILLIMETERS_TO_INCHES = 0.03937f;
+                auto dpi = pixelWidth / (width * MILLIMETERS_TO_INCHES);
+
+                // X11 does not enforce a default dpi.
+                // Use 96 dpi as our baseline DPI to match the behavior of Windows, and the default behavior of Linux Desktop Environments such as Gnome and KDE.
+                // See: https://scanline.ca/dpi/
+                return {screen, dpi / 96.0f};
+            }
+
+            return {screen, 1};
+        }
+
+        struct DisplayDeleter
+        {
+            void operator()(Display* display) const
+            {
+                XCloseDisplay(display);
+            }
+        };
+
+        std::mutex m_mutex{};
+        std::unique_ptr<Display, DisplayDeleter> m_display{};
+        int m_randrEventBase{-1};
+        std::unordered_map<Window, Metrics> m_metrics{};
+    };
+}
+
 namespace Babylon::Graphics
 {
     void DeviceImpl::ConfigureBgfxPlatformData(bgfx::PlatformData& pd, WindowT window)
@@ -12,28 +192,18 @@ namespace Babylon::Graphics
     {
     }
 
-    float DeviceImpl::GetDevicePixelRatio(WindowT)
+    float DeviceImpl::GetDevicePixelRatio(WindowT window)
     {
-        // TODO: We should persist a Display object instead of opening a new display.
-        // See https://github.com/BabylonJS/BabylonNative/issues/625
-
-        auto display = XOpenDisplay(nullptr);
-        auto screen = DefaultScreen(display);
-
-        auto width = DisplayWidthMM(display, screen);
-        auto pixelWidth = DisplayWidth(display, screen);
-
-        if (width > 0)
-        {
-            constexpr float MILLIMETERS_TO_INCHES = 0.03937f;
-            auto dpi = pixelWidth / (width * MILLIMETERS_TO_INCHES);
+        return DisplayMetricsCache::Get().GetDevicePixelRatio(window);
+    }
 
-            // X11 does not enforce a default dpi.
-            // Use 96 dpi as our baseline DPI to match the behavior of Windows, and the default behavior of Linux Desktop Environments such as Gnome and KDE.
-            // See: https://scanline.ca/dpi/
-            return dpi / 96.0f;
-        }
+    void DeviceImpl::InvalidateDisplayMetrics(WindowT window)
+    {
+        DisplayMetricsCache::Get().Invalidate(window);
+    }
 
-        return 1;
+    void DeviceImpl::ReleaseDisplayMetrics(WindowT window)
+    {
+        DisplayMetricsCache::Get().Release(window);
     }
-}
\ No newline at end of file
+}
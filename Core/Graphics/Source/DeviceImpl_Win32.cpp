@@ -21,4 +21,13 @@ namespace Babylon::Graphics
         // See https://docs.microsoft.com/en-us/windows/win32/learnwin32/dpi-and-device-independent-pixels
         return static_cast<float>(dpi) / 96.0f;
     }
+
+    void DeviceImpl::InvalidateDisplayMetrics(WindowT)
+    {
+        // The pixel ratio is queried from the platform without caching.
+    }
+
+    void DeviceImpl::ReleaseDisplayMetrics(WindowT)
+    {
+    }
 }
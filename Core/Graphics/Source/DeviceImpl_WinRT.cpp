@@ -38,4 +38,13 @@ namespace Babylon::Graphics
             return static_cast<float>(winrt::Windows::Graphics::Display::DisplayInformation::GetForCurrentView().RawPixelsPerViewPixel());
         }
     }
+
+    void DeviceImpl::InvalidateDisplayMetrics(WindowT)
+    {
+        // The pixel ratio is queried from the platform without caching.
+    }
+
+    void DeviceImpl::ReleaseDisplayMetrics(WindowT)
+    {
+    }
 }
\ No newline at end of file
@@ -16,4 +16,13 @@ namespace Babylon::Graphics
     {
         return window.contentScaleFactor;
     }
+
+    void DeviceImpl::InvalidateDisplayMetrics(WindowT)
+    {
+        // The pixel ratio is queried from the platform without caching.
+    }
+
+    void DeviceImpl::ReleaseDisplayMetrics(WindowT)
+    {
+    }
 }
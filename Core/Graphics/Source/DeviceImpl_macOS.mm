@@ -16,4 +16,13 @@ namespace Babylon::Graphics
     {
         return window.window.screen.backingScaleFactor;
     }
+
+    void DeviceImpl::InvalidateDisplayMetrics(WindowT)
+    {
+        // The pixel ratio is queried from the platform without caching.
+    }
+
+    void DeviceImpl::ReleaseDisplayMetrics(WindowT)
+    {
+    }
 }
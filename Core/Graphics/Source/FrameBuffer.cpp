@@ -30,15 +30,30 @@ namespace Babylon::Graphics
             return;
         }
 
-        if (bgfx::isValid(m_handle) && m_deviceID == m_deviceContext.GetDeviceId())
+        if (m_deviceID == m_deviceContext.GetDeviceId())
         {
-            bgfx::destroy(m_handle);
-            m_handle = BGFX_INVALID_HANDLE;
+            for (const auto attachment : m_trackedAttachments)
+            {
+                m_deviceContext.RemoveTexture(attachment);
+            }
+
+            if (bgfx::isValid(m_handle))
+            {
+                bgfx::destroy(m_handle);
+                m_handle = BGFX_INVALID_HANDLE;
+            }
         }
 
+        m_trackedAttachments.clear();
         m_disposed = true;
     }
 
+    void FrameBuffer::TrackAttachment(bgfx::TextureHandle handle, uint16_t width, uint16_t height, bgfx::TextureFormat::Enum format)
+    {
+        m_deviceContext.AddTexture(handle, width, height, false, 1, format);
+        m_trackedAttachments.push_back(handle);
+    }
+
     bgfx::FrameBufferHandle FrameBuffer::Handle() const
     {
         return m_handle;
@@ -46,12 +61,12 @@ namespace Babylon::Graphics
 
     uint16_t FrameBuffer::Width() const
     {
-        return (m_width == 0 ? static_cast<uint16_t>(m_deviceContext.GetWidth() / m_deviceContext.GetHardwareScalingLevel()) : m_width);
+        return (m_width == 0 ? static_cast<uint16_t>(m_deviceContext.GetWidth() / m_deviceContext.GetRenderScalingLevel()) : m_width);
     }
 
     uint16_t FrameBuffer::Height() const
     {
-        return (m_height == 0 ? static_cast<uint16_t>(m_deviceContext.GetHeight() / m_deviceContext.GetHardwareScalingLevel()) : m_height);
+        return (m_height == 0 ? static_cast<uint16_t>(m_deviceContext.GetHeight() / m_deviceContext.GetRenderScalingLevel()) : m_height);
     }
 
     bool FrameBuffer::DefaultBackBuffer() const
@@ -61,7 +76,11 @@ namespace Babylon::Graphics
 
     void FrameBuffer::Bind(bgfx::Encoder&)
     {
-        m_viewId.reset();
+        // Keep drawing into the current view if no other view has been started since, otherwise draws would be reordered.
+        if (!IsViewCurrent())
+        {
+            m_viewId.reset();
+        }
     }
 
     void FrameBuffer::Unbind(bgfx::Encoder&)
@@ -70,12 +89,11 @@ namespace Babylon::Graphics
 
     void FrameBuffer::Clear(bgfx::Encoder& encoder, uint16_t flags, uint32_t rgba, float depth, uint8_t stencil)
     {
-        // BGFX requires us to create a new viewID, this will ensure that the view gets cleared.
-        m_viewId = m_deviceContext.AcquireNewViewId(encoder);
+        // BGFX clears at the start of a view, so a new view is needed unless the current one is still empty.
+        AcquireViewId(encoder);
+        m_viewUsed = true;
 
-        bgfx::setViewMode(m_viewId.value(), bgfx::ViewMode::Sequential);
         bgfx::setViewClear(m_viewId.value(), flags, rgba, depth, stencil);
-        bgfx::setViewFrameBuffer(m_viewId.value(), m_handle);
 
         // If a scissor is not set, WebGL clears the entire screen, so set the view rect to cover the entire screen
         // before clearing to match WebGL's behavior; otherwise BGFX will only clear the view rect.
@@ -107,9 +125,8 @@ namespace Babylon::Graphics
             };
         }
 
-        // Reset the scissor rect now that we have a new view.
+        // The view scissor is never used, scissoring is applied per draw.
         bgfx::setViewScissor(m_viewId.value());
-        m_bgfxScissor = {};
 
         encoder.touch(m_viewId.value());
     }
@@ -117,25 +134,37 @@ namespace Babylon::Graphics
     void FrameBuffer::SetViewPort(bgfx::Encoder& encoder, float x, float y, float width, float height)
     {
         m_desiredViewPort = {x, y, width, height};
-        SetBgfxViewPortAndScissor(encoder, m_desiredViewPort, m_desiredScissor);
+        SetBgfxViewPort(encoder, m_desiredViewPort);
     }
 
-    void FrameBuffer::SetScissor(bgfx::Encoder& encoder, float x, float y, float width, float height)
+    void FrameBuffer::SetScissor(bgfx::Encoder&, float x, float y, float width, float height)
     {
+        // The scissor is set per draw in Submit so that scissor changes don't need a new view.
         m_desiredScissor = GetBgfxScissor(x, y, width, height);
-        SetBgfxViewPortAndScissor(encoder, m_desiredViewPort, m_desiredScissor);
     }
 
     void FrameBuffer::Submit(bgfx::Encoder& encoder, bgfx::ProgramHandle programHandle, uint8_t flags)
     {
-        SetBgfxViewPortAndScissor(encoder, m_desiredViewPort, m_desiredScissor);
+        SetBgfxViewPort(encoder, m_desiredViewPort);
+        m_viewUsed = true;
+
+        // bgfx intersects the draw scissor with the view rect, which matches WebGL clipping to the viewport.
+        if (m_desiredScissor.Width != 0.0f || m_desiredScissor.Height != 0.0f)
+        {
+            encoder.setScissor(
+                static_cast<uint16_t>(m_desiredScissor.X),
+                static_cast<uint16_t>(m_desiredScissor.Y),
+                static_cast<uint16_t>(m_desiredScissor.Width),
+                static_cast<uint16_t>(m_desiredScissor.Height));
+        }
+
         encoder.submit(m_viewId.value(), programHandle, 0, flags);
     }
 
     void FrameBuffer::Blit(bgfx::Encoder& encoder, bgfx::TextureHandle dst, uint16_t dstX, uint16_t dstY, bgfx::TextureHandle src, uint16_t srcX, uint16_t srcY, uint16_t width, uint16_t height)
     {
-        // In order for Blit to work properly we need to force the creation of a new ViewID.
-        SetBgfxViewPortAndScissor(encoder, m_desiredViewPort, m_desiredScissor);
+        SetBgfxViewPort(encoder, m_desiredViewPort);
+        m_viewUsed = true;
         encoder.blit(m_viewId.value(), dst, dstX, dstY, src, srcX, srcY, width, height);
     }
 
@@ -185,18 +214,36 @@ namespace Babylon::Graphics
         return Rect{x, y, width, height};
     }
 
-    void FrameBuffer::SetBgfxViewPortAndScissor(bgfx::Encoder& encoder, const Rect& viewPort, const Rect& scissor)
+    bool FrameBuffer::IsViewCurrent() const
+    {
+        return m_viewId.has_value() && m_viewFrameNumber == m_deviceContext.GetFrameNumber() && m_deviceContext.IsLastViewId(m_viewId.value());
+    }
+
+    void FrameBuffer::AcquireViewId(bgfx::Encoder& encoder)
     {
-        if (m_viewId.has_value() && viewPort.Equals(m_bgfxViewPort) && scissor.Equals(m_bgfxScissor))
+        // An empty view that is still the last one can take the new state instead of starting another view.
+        if (!IsViewCurrent() || m_viewUsed)
+        {
+            m_viewId = m_deviceContext.AcquireNewViewId(encoder);
+            m_viewFrameNumber = m_deviceContext.GetFrameNumber();
+            m_viewUsed = false;
+        }
+
+        bgfx::setViewMode(m_viewId.value(), bgfx::ViewMode::Sequential);
+        // Views without a framebuffer render into the back buffer, which is an internal framebuffer on offscreen devices.
+        bgfx::setViewFrameBuffer(m_viewId.value(), bgfx::isValid(m_handle) ? m_handle : m_deviceContext.GetBackBufferHandle());
+    }
+
+    void FrameBuffer::SetBgfxViewPort(bgfx::Encoder& encoder, const Rect& viewPort)
+    {
+        if (m_viewId.has_value() && m_viewFrameNumber == m_deviceContext.GetFrameNumber() && viewPort.Equals(m_bgfxViewPort))
         {
             return;
         }
 
-        m_viewId = m_deviceContext.AcquireNewViewId(encoder);
+        AcquireViewId(encoder);
 
-        bgfx::setViewMode(m_viewId.value(), bgfx::ViewMode::Sequential);
         bgfx::setViewClear(m_viewId.value(), BGFX_CLEAR_NONE, 0, 1.0f, 0);
-        bgfx::setViewFrameBuffer(m_viewId.value(), m_handle);
 
         m_bgfxViewPort = viewPort;
         bgfx::setViewRect(m_viewId.value(),
@@ -205,13 +252,7 @@ namespace Babylon::Graphics
             static_cast<uint16_t>(m_bgfxViewPort.Width * Width()),
             static_cast<uint16_t>(m_bgfxViewPort.Height * Height()));
 
-        m_bgfxScissor = scissor;
-        bgfx::setViewScissor(
-            m_viewId.value(),
-            static_cast<uint16_t>(m_bgfxScissor.X),
-            static_cast<uint16_t>(m_bgfxScissor.Y),
-            static_cast<uint16_t>(m_bgfxScissor.Width),
-            static_cast<uint16_t>(m_bgfxScissor.Height));
+        bgfx::setViewScissor(m_viewId.value());
     }
 
     bool Rect::Equals(const Rect& other) const
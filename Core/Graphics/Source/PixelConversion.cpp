@@ -0,0 +1,83 @@
+#include "PixelConversion.h"
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BABYLON_PIXEL_CONVERSION_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define BABYLON_PIXEL_CONVERSION_NEON
+#endif
+
+namespace
+{
+    uint32_t SwapRedBlue(uint32_t pixel)
+    {
+        return (pixel & 0xFF00FF00) | ((pixel & 0x00FF0000) >> 16) | ((pixel & 0x000000FF) << 16);
+    }
+
+    void SwapRedBlueRow(const uint8_t* source, uint8_t* destination, uint32_t width)
+    {
+        uint32_t x{0};
+
+#if defined(BABYLON_PIXEL_CONVERSION_SSE2)
+        const __m128i greenAlphaMask{_mm_set1_epi32(static_cast<int>(0xFF00FF00))};
+        const __m128i blueMask{_mm_set1_epi32(0x000000FF)};
+        for (; x + 4 <= width; x += 4)
+        {
+            const __m128i pixels{_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + x * 4))};
+            const __m128i greenAlpha{_mm_and_si128(pixels, greenAlphaMask)};
+            const __m128i red{_mm_and_si128(_mm_srli_epi32(pixels, 16), blueMask)};
+            const __m128i blue{_mm_slli_epi32(_mm_and_si128(pixels, blueMask), 16)};
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + x * 4), _mm_or_si128(greenAlpha, _mm_or_si128(red, blue)));
+        }
+#elif defined(BABYLON_PIXEL_CONVERSION_NEON)
+        for (; x + 16 <= width; x += 16)
+        {
+            uint8x16x4_t pixels{vld4q_u8(source + x * 4)};
+            const uint8x16_t first{pixels.val[0]};
+            pixels.val[0] = pixels.val[2];
+            pixels.val[2] = first;
+            vst4q_u8(destination + x * 4, pixels);
+        }
+#endif
+
+        for (; x < width; ++x)
+        {
+            uint32_t pixel{};
+            std::memcpy(&pixel, source + x * 4, sizeof(pixel));
+            pixel = SwapRedBlue(pixel);
+            std::memcpy(destination + x * 4, &pixel, sizeof(pixel));
+        }
+    }
+}
+
+namespace Babylon::Graphics
+{
+    void CopyPixels32(const uint8_t* source, uint32_t sourcePitch, uint8_t* destination, uint32_t destinationPitch, uint32_t width, uint32_t height, bool swapRedBlue, bool flipY)
+    {
+        const size_t rowSize{static_cast<size_t>(width) * 4};
+
+        // Tightly packed images without conversion are a single copy.
+        if (!swapRedBlue && !flipY && sourcePitch == rowSize && destinationPitch == rowSize)
+        {
+            std::memcpy(destination, source, rowSize * height);
+            return;
+        }
+
+        for (uint32_t y = 0; y < height; ++y)
+        {
+            const uint8_t* sourceRow{source + static_cast<size_t>(flipY ? height - y - 1 : y) * sourcePitch};
+            uint8_t* destinationRow{destination + static_cast<size_t>(y) * destinationPitch};
+            if (swapRedBlue)
+            {
+                SwapRedBlueRow(sourceRow, destinationRow, width);
+            }
+            else
+            {
+                std::memcpy(destinationRow, sourceRow, rowSize);
+            }
+        }
+    }
+}
@@ -1,5 +1,8 @@
 #include "Texture.h"
 #include "DeviceContext.h"
+#include <arcana/threading/task.h>
+#include <arcana/threading/task_schedulers.h>
+#include <algorithm>
 #include <cassert>
 
 namespace Babylon::Graphics
@@ -15,8 +18,36 @@ namespace Babylon::Graphics
         Dispose();
     }
 
+    void Texture::Track()
+    {
+        if (!bgfx::isValid(m_handle))
+        {
+            return;
+        }
+
+        m_lastUseFrame = m_deviceContext.GetFrameNumber();
+        m_deviceContext.AddTexture(*this);
+        m_tracked = true;
+    }
+
     void Texture::Dispose()
     {
+        if (m_tracked)
+        {
+            m_deviceContext.RemoveTexture(*this);
+            m_tracked = false;
+        }
+
+        {
+            // Abandons any restore that is still running in the background.
+            std::scoped_lock lock{m_restoreState->Mutex};
+            m_restoreState->Callback = {};
+            m_restoreState->Upload = {};
+            m_restoreState->Generation++;
+            m_restoreState->Restoring = false;
+            m_restoreState->Evicted = false;
+        }
+
         if (m_ownsHandle && bgfx::isValid(m_handle) && m_deviceID == m_deviceContext.GetDeviceId())
         {
             bgfx::destroy(m_handle);
@@ -43,6 +74,8 @@ namespace Babylon::Graphics
         m_numLayers = numLayers;
         m_format = format;
         m_flags = flags;
+        m_cubeMap = false;
+        Track();
     }
 
     void Texture::Update2D(uint16_t layer, uint8_t mip, uint16_t x, uint16_t y, uint16_t width, uint16_t height, const bgfx::Memory* mem, uint16_t pitch)
@@ -62,6 +95,8 @@ namespace Babylon::Graphics
         m_numLayers = numLayers;
         m_format = format;
         m_flags = flags;
+        m_cubeMap = true;
+        Track();
     }
 
     void Texture::UpdateCube(uint16_t layer, uint8_t side, uint8_t mip, uint16_t x, uint16_t y, uint16_t width, uint16_t height, const bgfx::Memory* mem, uint16_t pitch)
@@ -82,12 +117,170 @@ namespace Babylon::Graphics
         m_numLayers = numLayers;
         m_format = format;
         m_flags = flags;
+        m_cubeMap = false;
+        Track();
     }
 
     void Texture::Disown()
     {
         assert(m_ownsHandle);
         m_ownsHandle = false;
+
+        // The handle is now owned by someone else (e.g. a frame buffer) and can no longer be evicted.
+        std::scoped_lock lock{m_restoreState->Mutex};
+        m_restoreState->Callback = {};
+    }
+
+    void Texture::MarkShared()
+    {
+        m_shared = true;
+    }
+
+    bool Texture::IsShared() const
+    {
+        return m_shared;
+    }
+
+    void Texture::SetRestoreCallback(RestoreCallback callback)
+    {
+        std::scoped_lock lock{m_restoreState->Mutex};
+        m_restoreState->Callback = std::move(callback);
+    }
+
+    bool Texture::IsEvictable() const
+    {
+        std::scoped_lock lock{m_restoreState->Mutex};
+        return m_restoreState->Callback && m_ownsHandle && bgfx::isValid(m_handle) && m_deviceID == m_deviceContext.GetDeviceId();
+    }
+
+    bool Texture::IsEvicted() const
+    {
+        std::scoped_lock lock{m_restoreState->Mutex};
+        return m_restoreState->Evicted;
+    }
+
+    void Texture::Evict()
+    {
+        assert(IsEvictable());
+
+        RestoreCallback callback{};
+        {
+            std::scoped_lock lock{m_restoreState->Mutex};
+            callback = std::move(m_restoreState->Callback);
+        }
+
+        Dispose();
+
+        std::scoped_lock lock{m_restoreState->Mutex};
+        m_restoreState->Callback = std::move(callback);
+        m_restoreState->Evicted = true;
+    }
+
+    bool Texture::MakeResident()
+    {
+        std::unique_lock lock{m_restoreState->Mutex};
+        if (!m_restoreState->Evicted)
+        {
+            return true;
+        }
+
+        if (m_restoreState->Upload)
+        {
+            UploadCallback upload{std::move(m_restoreState->Upload)};
+            m_restoreState->Upload = {};
+            lock.unlock();
+            Upload(std::move(upload));
+            return true;
+        }
+
+        if (!m_restoreState->Restoring && m_restoreState->Callback)
+        {
+            m_restoreState->Restoring = true;
+            arcana::make_task(arcana::threadpool_scheduler, arcana::cancellation::none(),
+                [state{m_restoreState}, callback{m_restoreState->Callback}, generation{m_restoreState->Generation}]() {
+                    UploadCallback upload{};
+                    try
+                    {
+                        upload = callback();
+                    }
+                    catch (...)
+                    {
+                    }
+
+                    std::scoped_lock lock{state->Mutex};
+                    if (state->Generation == generation)
+                    {
+                        // A texture that fails to restore stays evicted rather than retrying every frame.
+                        if (!upload)
+                        {
+                            state->Callback = {};
+                        }
+
+                        state->Upload = std::move(upload);
+                        state->Restoring = false;
+                    }
+                });
+        }
+
+        return false;
+    }
+
+    void Texture::MakeResidentNow()
+    {
+        RestoreCallback callback{};
+        {
+            std::scoped_lock lock{m_restoreState->Mutex};
+            if (!m_restoreState->Evicted || !m_restoreState->Callback)
+            {
+                return;
+            }
+
+            // Supersedes a restore that is still running in the background.
+            callback = m_restoreState->Callback;
+            m_restoreState->Upload = {};
+            m_restoreState->Generation++;
+            m_restoreState->Restoring = false;
+        }
+
+        Upload(callback());
+    }
+
+    void Texture::Upload(UploadCallback upload)
+    {
+        if (!upload)
+        {
+            return;
+        }
+
+        // Recreating the texture disposes the previous state, so hold on to the callback while the upload runs.
+        RestoreCallback callback{};
+        {
+            std::scoped_lock lock{m_restoreState->Mutex};
+            callback = m_restoreState->Callback;
+        }
+
+        upload(*this);
+
+        std::scoped_lock lock{m_restoreState->Mutex};
+        m_restoreState->Callback = std::move(callback);
+        m_restoreState->Evicted = false;
+    }
+
+    void Texture::Touch()
+    {
+        m_lastUseFrame = m_deviceContext.GetFrameNumber();
+    }
+
+    uint32_t Texture::LastUseFrame() const
+    {
+        return m_lastUseFrame;
+    }
+
+    size_t Texture::SizeInBytes() const
+    {
+        bgfx::TextureInfo info{};
+        bgfx::calcTextureSize(info, m_width, m_height, /*depth*/ 1, m_cubeMap, m_hasMips, std::max<uint16_t>(m_numLayers, 1), m_format);
+        return info.storageSize;
     }
 
     bgfx::TextureHandle Texture::Handle() const
@@ -115,6 +308,11 @@ namespace Babylon::Graphics
         return m_numLayers;
     }
 
+    bool Texture::IsCubeMap() const
+    {
+        return m_cubeMap;
+    }
+
     bgfx::TextureFormat::Enum Texture::Format() const
     {
         return m_format;
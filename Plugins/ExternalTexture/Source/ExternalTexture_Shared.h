@@ -64,6 +64,14 @@ namespace Babylon::Plugins
         auto deferred{Napi::Promise::Deferred::New(env)};
         auto promise{deferred.Promise()};
 
+        // The native texture is bound with bgfx::overrideInternal, which must run on the render thread. With multithreaded
+        // rendering that thread belongs to bgfx, so external textures are not supported.
+        if (context.IsMultithreaded())
+        {
+            deferred.Reject(Napi::Error::New(env, "External textures are not supported with multithreaded rendering").Value());
+            return promise;
+        }
+
         arcana::make_task(context.BeforeRenderScheduler(), arcana::cancellation_source::none(),
             [&context, &runtime, deferred = std::move(deferred), impl = m_impl]() {
                 // REVIEW: The bgfx texture handle probably needs to be an RAII object to make sure it gets clean up during the asynchrony.
@@ -27,6 +27,14 @@ namespace Babylon::Plugins::Internal
             auto deferred = Napi::Promise::Deferred::New(env);
             auto promise = deferred.Promise();
 
+            // Camera frames are bound with bgfx::overrideInternal, which must run on the render thread. With multithreaded
+            // rendering that thread belongs to bgfx, so cameras are not supported.
+            if (Graphics::DeviceContext::GetFromJavaScript(env).IsMultithreaded())
+            {
+                deferred.Reject(Napi::Error::New(env, "Cameras are not supported with multithreaded rendering").Value());
+                return std::move(promise);
+            }
+
             // Extract the video constraints as we only support video for the time being
             auto videoConstraints{Napi::Object::New(env)};
             if (info.Length() > 0 && info[0].IsObject())
@@ -2,6 +2,7 @@
 #include <Babylon/JsRuntime.h>
 #include <Babylon/Graphics/DeviceContext.h>
 #include <Babylon/Graphics/FrameBuffer.h>
+#include <Babylon/Graphics/PixelConversion.h>
 
 #include <napi/napi_pointer.h>
 
@@ -11,7 +12,7 @@
 
 namespace
 {
-    using FrameCallback = std::function<void(uint32_t width, uint32_t height, bgfx::TextureFormat::Enum format, bool yFlip, gsl::span<const uint8_t> data)>;
+    using FrameCallback = std::function<void(uint32_t width, uint32_t height, uint32_t pitch, bgfx::TextureFormat::Enum format, bool yFlip, gsl::span<const uint8_t> data)>;
     using FrameProviderCleanup = std::function<void()>;
     using FrameProviderTicket = gsl::final_action<FrameProviderCleanup>;
 
@@ -39,7 +40,7 @@ namespace
             void StartCapture()
             {
                 m_ticket = std::make_unique<Babylon::Graphics::DeviceContext::CaptureCallbackTicketT>(m_graphicsContext.AddCaptureCallback([thisRef{shared_from_this()}](auto& data) {
-                    thisRef->m_frameCallback(data.Width, data.Height, data.Format, data.YFlip, {static_cast<const uint8_t*>(data.Data), static_cast<std::size_t>(data.DataSize)});
+                    thisRef->m_frameCallback(data.Width, data.Height, data.Pitch, data.Format, data.YFlip, {static_cast<const uint8_t*>(data.Data), static_cast<std::size_t>(data.DataSize)});
                 }));
             }
 
@@ -84,7 +85,7 @@ namespace
             {
                 return arcana::make_task(m_graphicsContext.AfterRenderScheduler(), m_cancellationToken, [thisRef{shared_from_this()}] {
                     // bgfx does not allow readback of render textures, so the frame buffer render texture needs to be blitted to a texture with readback enabled.
-                    bgfx::blit(static_cast<uint16_t>(bgfx::getCaps()->limits.maxViews - 1), thisRef->m_blitTextureHandle, 0, 0, thisRef->m_frameBufferTextureHandle);
+                    bgfx::blit(Babylon::Graphics::DeviceContext::GetBlitViewId(), thisRef->m_blitTextureHandle, 0, 0, thisRef->m_frameBufferTextureHandle);
 
                     // Reading the texture is an async operation, but everything that needs to be done prior to future write operations on that texture is completed synchronously,
                     // so we kick off the read for the next frame prior to the read for the current frame completes.
@@ -93,7 +94,11 @@ namespace
                     arcana::task<void, std::exception_ptr> readCurrentFrameTask{
                         thisRef->m_graphicsContext.ReadTextureAsync(thisRef->m_blitTextureHandle, thisRef->m_textureBuffer)
                             .then(arcana::inline_scheduler, thisRef->m_cancellationToken, [thisRef] {
-                                thisRef->m_frameCallback(thisRef->m_textureInfo.Width, thisRef->m_textureInfo.Height, thisRef->m_textureInfo.Format, bgfx::getCaps()->originBottomLeft, thisRef->m_textureBuffer);
+                                const auto& info{thisRef->m_textureInfo};
+                                bgfx::TextureInfo rowInfo{};
+                                bgfx::calcTextureSize(rowInfo, info.Width, 1, 1, false, false, 1, info.Format);
+                                const uint32_t pitch{rowInfo.storageSize};
+                                thisRef->m_frameCallback(info.Width, info.Height, pitch, info.Format, bgfx::getCaps()->originBottomLeft, thisRef->m_textureBuffer);
                             })};
 
                     arcana::task<void, std::exception_ptr> readNextFrameTask{thisRef->ReadTextureAsync()};
@@ -159,8 +164,8 @@ namespace Babylon::Plugins::Internal
             Napi::Object jsData = m_jsData.Value();
             jsData.Set("data", Napi::ArrayBuffer::New(info.Env(), 0));
 
-            FrameCallback frameCallback{[this](uint32_t width, uint32_t height, bgfx::TextureFormat::Enum format, bool yFlip, gsl::span<const uint8_t> data) {
-                CaptureDataReceived(width, height, format, yFlip, data);
+            FrameCallback frameCallback{[this](uint32_t width, uint32_t height, uint32_t pitch, bgfx::TextureFormat::Enum format, bool yFlip, gsl::span<const uint8_t> data) {
+                CaptureDataReceived(width, height, pitch, format, yFlip, data);
             }};
 
             bgfx::FrameBufferHandle frameBufferHandle{bgfx::kInvalidHandle};
@@ -196,11 +201,23 @@ namespace Babylon::Plugins::Internal
             m_callbacks.push_back(Napi::Persistent(listener));
         }
 
-        void CaptureDataReceived(uint32_t width, uint32_t height, bgfx::TextureFormat::Enum format, bool yFlip, gsl::span<const uint8_t> data)
+        void CaptureDataReceived(uint32_t width, uint32_t height, uint32_t pitch, bgfx::TextureFormat::Enum format, bool yFlip, gsl::span<const uint8_t> data)
         {
+            // The data is only valid during this call. 32-bit frames are converted to tightly packed, top down RGBA8 in the
+            // same pass as the copy, other formats are copied as is.
             std::vector<uint8_t> bytes{};
-            bytes.resize(data.size());
-            std::memcpy(bytes.data(), data.data(), data.size());
+            if ((format == bgfx::TextureFormat::RGBA8 || format == bgfx::TextureFormat::BGRA8) && data.size() >= static_cast<size_t>(pitch) * height)
+            {
+                bytes.resize(static_cast<size_t>(width) * height * 4);
+                Graphics::CopyPixels32(data.data(), pitch, bytes.data(), width * 4, width, height, format == bgfx::TextureFormat::BGRA8, yFlip);
+                format = bgfx::TextureFormat::RGBA8;
+                yFlip = false;
+            }
+            else
+            {
+                bytes.assign(data.begin(), data.end());
+            }
+
             m_runtime.Dispatch([this, width, height, format, yFlip, bytes{std::move(bytes)}](Napi::Env env) mutable {
                 Napi::Object jsData = m_jsData.Value();
                 jsData.Set("width", static_cast<double>(width));
@@ -220,14 +237,9 @@ namespace Babylon::Plugins::Internal
                 }
                 jsData.Set("yFlip", yFlip);
 
-                auto jsBytes = jsData.Get("data").As<Napi::ArrayBuffer>();
-                if (static_cast<size_t>(bytes.size()) != jsBytes.ByteLength())
-                {
-                    jsBytes = Napi::ArrayBuffer::New(env, bytes.size());
-                    jsData.Set("data", jsBytes);
-                }
-                std::memcpy(jsBytes.Data(), bytes.data(), bytes.size());
-                bytes.clear();
+                // Hand the converted frame over to JavaScript without copying it again.
+                auto* frame{new std::vector<uint8_t>{std::move(bytes)}};
+                jsData.Set("data", Napi::ArrayBuffer::New(env, frame->data(), frame->size(), [frame](Napi::Env, void*) { delete frame; }));
 
                 for (const auto& callback : m_callbacks)
                 {
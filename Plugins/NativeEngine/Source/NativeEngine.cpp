@@ -1,6 +1,7 @@
 #include "NativeEngine.h"
 #include "ShaderCompiler.h"
 
+#include <Babylon/Graphics/Device.h>
 #include <Babylon/Graphics/Texture.h>
 #include "JsConsoleLogger.h"
 
@@ -22,6 +23,7 @@
 #include <bx/math.h>
 
 #include <cmath>
+#include <utility>
 
 namespace Babylon
 {
@@ -314,6 +316,132 @@ namespace Babylon
             }
         }
 
+        // Returns the byte size of a single layer of raw texture data, including its mip chain if present.
+        uint32_t GetRawLayerSize(bimg::TextureFormat::Enum format, uint16_t width, uint16_t height, uint8_t numMips)
+        {
+            uint32_t size{0};
+            for (uint8_t mip = 0; mip < numMips; ++mip)
+            {
+                const auto mipWidth{static_cast<uint16_t>(std::max(1, width >> mip))};
+                const auto mipHeight{static_cast<uint16_t>(std::max(1, height >> mip))};
+                size += bimg::imageGetSize(nullptr, mipWidth, mipHeight, 1, false, false, 1, format);
+            }
+
+            return size;
+        }
+
+        // Returns the format that PrepareImage produces when generating mips for an image of the given format.
+        bimg::TextureFormat::Enum GetMipGenerationFormat(bimg::TextureFormat::Enum format)
+        {
+            switch (format)
+            {
+                case bimg::TextureFormat::RGB8:
+                    return bimg::TextureFormat::RGBA8;
+                case bimg::TextureFormat::RGBA16:
+                    return bimg::TextureFormat::RGBA32F;
+                case bimg::TextureFormat::RGBA8:
+                case bimg::TextureFormat::RGBA32F:
+                    return format;
+                default:
+                    throw std::runtime_error{"Mipmap generation is not supported for this texture format"};
+            }
+        }
+
+        // Uploads tightly packed layers of raw data into a 2D array texture, starting at firstLayer. When dataHasMips is set, each layer is
+        // followed by its mip chain. Mips are generated if the texture has mips but the data does not. The data is copied, so the caller is
+        // free to reuse it right away.
+        void UpdateTexture2DArrayLayers(Graphics::Texture* texture, gsl::span<const uint8_t> data, bimg::TextureFormat::Enum format, uint16_t firstLayer, bool dataHasMips, bool invertY)
+        {
+            const uint16_t width{texture->Width()};
+            const uint16_t height{texture->Height()};
+            const uint8_t numMips{bimg::imageGetNumMips(format, width, height)};
+
+            if (invertY && bimg::isCompressed(format))
+            {
+                throw std::runtime_error{"Texture 2D array does not support invert Y for compressed formats"};
+            }
+
+            if (dataHasMips && !texture->HasMips())
+            {
+                throw std::runtime_error{"The data has mips but the texture does not"};
+            }
+
+            // Generated mips are uploaded in the format PrepareImage converts to, which the texture was created with.
+            const bool generateMips{texture->HasMips() && !dataHasMips};
+            const bimg::TextureFormat::Enum uploadFormat{generateMips ? GetMipGenerationFormat(format) : format};
+            if (uploadFormat != static_cast<bimg::TextureFormat::Enum>(texture->Format()))
+            {
+                throw std::runtime_error{"The data format does not match the format of the texture"};
+            }
+
+            const uint32_t dataLayerSize{GetRawLayerSize(format, width, height, dataHasMips ? numMips : 1)};
+            if (data.size() % dataLayerSize != 0)
+            {
+                throw std::runtime_error{"The data size does not match width, height, layers and format"};
+            }
+
+            const auto numLayers{static_cast<uint16_t>(data.size() / dataLayerSize)};
+            if (firstLayer + numLayers > texture->NumLayers())
+            {
+                throw std::runtime_error{"The data contains more layers than the texture"};
+            }
+
+            const uint32_t layerSize{GetRawLayerSize(format, width, height, 1)};
+
+            const uint8_t* layerData{data.data()};
+            for (uint16_t layer = firstLayer; layer < firstLayer + numLayers; ++layer)
+            {
+                if (generateMips)
+                {
+                    bimg::ImageContainer* image{bimg::imageAlloc(&Graphics::DeviceContext::GetDefaultAllocator(), format, width, height, 1, 1, false, false, layerData)};
+                    if (invertY)
+                    {
+                        FlipImage({static_cast<uint8_t*>(image->m_data), image->m_size}, image->m_height);
+                    }
+
+                    // PrepareImage flips depending on the renderer origin, so pass the value that leaves the image as is.
+                    image = PrepareImage(Graphics::DeviceContext::GetDefaultAllocator(), image, !bgfx::getCaps()->originBottomLeft, false, true);
+
+                    for (uint8_t mip = 0; mip < image->m_numMips; ++mip)
+                    {
+                        bimg::ImageMip imageMip{};
+                        if (bimg::imageGetRawData(*image, 0, mip, image->m_data, image->m_size, imageMip))
+                        {
+                            bgfx::ReleaseFn releaseFn{};
+                            if (mip == image->m_numMips - 1)
+                            {
+                                releaseFn = [](void*, void* userData) {
+                                    bimg::imageFree(static_cast<bimg::ImageContainer*>(userData));
+                                };
+                            }
+
+                            const bgfx::Memory* mem{bgfx::makeRef(imageMip.m_data, imageMip.m_size, releaseFn, image)};
+                            texture->Update2D(layer, mip, 0, 0, static_cast<uint16_t>(imageMip.m_width), static_cast<uint16_t>(imageMip.m_height), mem);
+                        }
+                    }
+
+                    layerData += layerSize;
+                    continue;
+                }
+
+                for (uint8_t mip = 0; mip < (dataHasMips ? numMips : 1); ++mip)
+                {
+                    const auto mipWidth{static_cast<uint16_t>(std::max(1, width >> mip))};
+                    const auto mipHeight{static_cast<uint16_t>(std::max(1, height >> mip))};
+                    const uint32_t mipSize{bimg::imageGetSize(nullptr, mipWidth, mipHeight, 1, false, false, 1, format)};
+
+                    const bgfx::Memory* mem{bgfx::copy(layerData, mipSize)};
+                    if (invertY)
+                    {
+                        FlipImage({mem->data, mem->size}, mipHeight);
+                    }
+
+                    texture->Update2D(layer, mip, 0, 0, mipWidth, mipHeight, mem);
+                    layerData += mipSize;
+                }
+            }
+        }
+
         void LoadCubeTextureFromImages(Graphics::Texture* texture, std::vector<bimg::ImageContainer*>& images, bool srgb)
         {
             const bimg::ImageContainer* firstImage{images.front()};
@@ -397,6 +525,19 @@ namespace Babylon
             return BGFX_TEXTURE_NONE;
         }
 
+        Napi::Value CreateTextureAtlasRegion(Napi::Env env, uint32_t id, const TextureAtlas::Region& region)
+        {
+            auto jsRegion{Napi::Object::New(env)};
+            jsRegion.Set("id", Napi::Value::From(env, id));
+            // The page texture stays alive for as long as JavaScript references it, even if compaction replaces it.
+            jsRegion.Set("texture", Napi::Pointer<Graphics::Texture>::Create(env, region.Page.get(), [page = region.Page]() {}));
+            jsRegion.Set("u0", Napi::Value::From(env, region.U0));
+            jsRegion.Set("v0", Napi::Value::From(env, region.V0));
+            jsRegion.Set("u1", Napi::Value::From(env, region.U1));
+            jsRegion.Set("v1", Napi::Value::From(env, region.V1));
+            return std::move(jsRegion);
+        }
+
         using CommandFunctionPointerT = void (NativeEngine::*)(NativeDataStream::Reader&);
     }
 
@@ -670,6 +811,8 @@ namespace Babylon
                 InstanceMethod("loadTexture", &NativeEngine::LoadTexture),
                 InstanceMethod("loadRawTexture", &NativeEngine::LoadRawTexture),
                 InstanceMethod("loadRawTexture2DArray", &NativeEngine::LoadRawTexture2DArray),
+                InstanceMethod("updateRawTexture2DArray", &NativeEngine::UpdateRawTexture2DArray),
+                InstanceMethod("updateTexture", &NativeEngine::UpdateTexture),
                 InstanceMethod("loadCubeTexture", &NativeEngine::LoadCubeTexture),
                 InstanceMethod("loadCubeTextureWithMips", &NativeEngine::LoadCubeTextureWithMips),
                 InstanceMethod("getTextureWidth", &NativeEngine::GetTextureWidth),
@@ -677,6 +820,15 @@ namespace Babylon
                 InstanceMethod("copyTexture", &NativeEngine::CopyTexture),
                 InstanceMethod("deleteTexture", &NativeEngine::DeleteTexture),
                 InstanceMethod("readTexture", &NativeEngine::ReadTexture),
+                InstanceMethod("getTextureMemoryStats", &NativeEngine::GetTextureMemoryStats),
+
+                InstanceMethod("createTextureAtlas", &NativeEngine::CreateTextureAtlas),
+                InstanceMethod("addToTextureAtlas", &NativeEngine::AddToTextureAtlas),
+                InstanceMethod("removeFromTextureAtlas", &NativeEngine::RemoveFromTextureAtlas),
+                InstanceMethod("getTextureAtlasRegion", &NativeEngine::GetTextureAtlasRegion),
+                InstanceMethod("getTextureAtlasFragmentation", &NativeEngine::GetTextureAtlasFragmentation),
+                InstanceMethod("compactTextureAtlas", &NativeEngine::CompactTextureAtlas),
+                InstanceMethod("setTextureMemoryBudget", &NativeEngine::SetTextureMemoryBudget),
 
                 InstanceMethod("createImageBitmap", &NativeEngine::CreateImageBitmap),
                 InstanceMethod("resizeImageBitmap", &NativeEngine::ResizeImageBitmap),
@@ -687,6 +839,9 @@ namespace Babylon
                 InstanceMethod("getRenderHeight", &NativeEngine::GetRenderHeight),
                 InstanceMethod("getHardwareScalingLevel", &NativeEngine::GetHardwareScalingLevel),
                 InstanceMethod("setHardwareScalingLevel", &NativeEngine::SetHardwareScalingLevel),
+                InstanceMethod("getRenderScale", &NativeEngine::GetRenderScale),
+                InstanceMethod("setDynamicResolution", &NativeEngine::SetDynamicResolution),
+                InstanceMethod("getFrameStats", &NativeEngine::GetFrameStats),
 
                 InstanceMethod("setCommandDataStream", &NativeEngine::SetCommandDataStream),
                 InstanceMethod("submitCommands", &NativeEngine::SubmitCommands),
@@ -725,6 +880,24 @@ namespace Babylon
     void NativeEngine::Dispose()
     {
         m_cancellationSource->cancel();
+
+        // Handles from before a device reset are stale and are dropped without being destroyed.
+        const auto deviceId{m_deviceContext.GetDeviceId()};
+        for (const auto& texture : m_readbackTextures)
+        {
+            if (texture.DeviceId == deviceId)
+            {
+                bgfx::destroy(texture.Handle);
+            }
+        }
+        m_readbackTextures.clear();
+        m_readbackBuffers.clear();
+
+        if (bgfx::isValid(m_placeholderTexture) && m_placeholderTextureDeviceId == deviceId)
+        {
+            bgfx::destroy(m_placeholderTexture);
+        }
+        m_placeholderTexture = BGFX_INVALID_HANDLE;
     }
 
     void NativeEngine::Dispose(const Napi::CallbackInfo& /*info*/)
@@ -1354,19 +1527,44 @@ namespace Babylon
 
         const auto dataSpan = gsl::make_span(static_cast<uint8_t*>(data.ArrayBuffer().Data()) + data.ByteOffset(), data.ByteLength());
 
+        // Keep a copy of the encoded data when a texture memory budget is set so the texture can be evicted and re-streamed on demand.
+        const bool restorable{m_deviceContext.GetTextureMemoryBudget() != 0};
+
         arcana::make_task(arcana::threadpool_scheduler, *m_cancellationSource,
-            [dataSpan, generateMips, invertY, srgb, texture, cancellationSource{m_cancellationSource}]() {
+            [dataSpan, generateMips, invertY, srgb, texture, restorable, cancellationSource{m_cancellationSource}]() {
                 bimg::ImageContainer* image{ParseImage(Graphics::DeviceContext::GetDefaultAllocator(), dataSpan)};
                 image = PrepareImage(Graphics::DeviceContext::GetDefaultAllocator(), image, invertY, srgb, generateMips);
                 LoadTextureFromImage(texture, image, srgb);
+                return restorable ? std::vector<uint8_t>{dataSpan.begin(), dataSpan.end()} : std::vector<uint8_t>{};
             })
-            .then(m_runtimeScheduler, *m_cancellationSource, [dataRef{Napi::Persistent(data)}, onSuccessRef{Napi::Persistent(onSuccess)}, onErrorRef{Napi::Persistent(onError)}, cancellationSource{m_cancellationSource}](arcana::expected<void, std::exception_ptr> result) {
+            .then(m_runtimeScheduler, *m_cancellationSource, [texture, generateMips, invertY, srgb, dataRef{Napi::Persistent(data)}, onSuccessRef{Napi::Persistent(onSuccess)}, onErrorRef{Napi::Persistent(onError)}, cancellationSource{m_cancellationSource}](arcana::expected<std::vector<uint8_t>, std::exception_ptr> result) {
                 if (result.has_error())
                 {
                     onErrorRef.Call({});
                 }
                 else
                 {
+                    if (!result.value().empty())
+                    {
+                        // Decodes on the thread pool, uploads on the JavaScript thread.
+                        texture->SetRestoreCallback([encodedData{std::make_shared<std::vector<uint8_t>>(std::move(result.value()))}, generateMips, invertY, srgb]() -> Graphics::Texture::UploadCallback {
+                            bimg::ImageContainer* image{ParseImage(Graphics::DeviceContext::GetDefaultAllocator(), *encodedData)};
+                            image = PrepareImage(Graphics::DeviceContext::GetDefaultAllocator(), image, invertY, srgb, generateMips);
+
+                            // The upload hands the image over to bgfx. A restore that is abandoned before it uploads frees it instead.
+                            std::shared_ptr<bimg::ImageContainer*> pendingImage{new bimg::ImageContainer*{image}, [](bimg::ImageContainer** image) {
+                                if (*image != nullptr)
+                                {
+                                    bimg::imageFree(*image);
+                                }
+                                delete image;
+                            }};
+                            return [pendingImage, srgb](Graphics::Texture& texture) {
+                                LoadTextureFromImage(&texture, std::exchange(*pendingImage, nullptr), srgb);
+                            };
+                        });
+                    }
+
                     onSuccessRef.Call({});
                 }
             });
@@ -1379,6 +1577,8 @@ namespace Babylon
 
         arcana::make_task(m_update.Scheduler(), *m_cancellationSource, [this, textureDestination, textureSource, cancellationSource = m_cancellationSource]() {
             return arcana::make_task(m_runtimeScheduler, *m_cancellationSource, [this, textureDestination, textureSource, updateToken = m_update.GetUpdateToken(), cancellationSource = m_cancellationSource]() {
+                textureSource->MakeResidentNow();
+                textureSource->Touch();
                 bgfx::Encoder* encoder = m_update.GetUpdateToken().GetEncoder();
                 GetBoundFrameBuffer(*encoder).Blit(*encoder, textureDestination->Handle(), 0, 0, textureSource->Handle());
             }).then(arcana::inline_scheduler, *m_cancellationSource, [this, cancellationSource{m_cancellationSource}](const arcana::expected<void, std::exception_ptr>& result) {
@@ -1421,39 +1621,155 @@ namespace Babylon
         const auto format{static_cast<bimg::TextureFormat::Enum>(info[5].As<Napi::Number>().Uint32Value())};
         const auto generateMips = info[6].As<Napi::Boolean>().Value();
         const auto invertY = info[7].As<Napi::Boolean>().Value();
+        const auto dataHasMips{!data.IsNull() && !info[8].IsUndefined() && info[8].As<Napi::Boolean>().Value()};
+
+        // Data may contain a full mip chain for each layer, in which case the texture gets mips even if generateMips is false.
+        const uint8_t numMips{dataHasMips ? bimg::imageGetNumMips(format, width, height) : uint8_t{1}};
+        const bool hasMips{generateMips || dataHasMips};
 
-        if (generateMips)
+        if (!data.IsNull() && data.ByteLength() != static_cast<size_t>(GetRawLayerSize(format, width, height, numMips)) * depth)
         {
-            throw Napi::Error::New(Env(), "Texture 2D array currently do not support mipmaps.");
+            throw Napi::Error::New(Env(), "The data size does not match width, height, depth, format and mips");
         }
 
-        if (invertY)
+        bimg::TextureFormat::Enum textureFormat{format};
+        if (generateMips && !dataHasMips)
         {
-            throw Napi::Error::New(Env(), "Texture 2D array currently do not support invert Y.");
+            try
+            {
+                textureFormat = GetMipGenerationFormat(format);
+            }
+            catch (const std::exception& exception)
+            {
+                throw Napi::Error::New(Env(), exception.what());
+            }
         }
 
         uint64_t flags{BGFX_TEXTURE_NONE | BGFX_SAMPLER_NONE | BGFX_CAPS_TEXTURE_2D_ARRAY};
-        texture->Create2D(width, height, generateMips, depth, Cast(format), flags);
+        texture->Create2D(width, height, hasMips, depth, Cast(textureFormat), flags);
 
         if (!data.IsNull())
         {
-            if (data.ByteLength() != bimg::imageGetSize(nullptr, width, height, 1, false, false, depth, format))
-            {
-                throw Napi::Error::New(Env(), "The data size does not match width, height, depth and format");
-            }
+            UpdateRawTexture2DArrayLayers(texture, data, format, 0, dataHasMips, invertY);
+        }
+    }
+
+    void NativeEngine::UpdateRawTexture2DArray(const Napi::CallbackInfo& info)
+    {
+        const auto texture{info[0].As<Napi::Pointer<Graphics::Texture>>().Get()};
+        const auto data{info[1].As<Napi::TypedArray>()};
+        const auto firstLayer{static_cast<uint16_t>(info[2].As<Napi::Number>().Uint32Value())};
+        const auto format{static_cast<bimg::TextureFormat::Enum>(info[3].As<Napi::Number>().Uint32Value())};
+        const auto invertY{info[4].As<Napi::Boolean>().Value()};
+        const auto dataHasMips{!info[5].IsUndefined() && info[5].As<Napi::Boolean>().Value()};
 
-            uint8_t* dataPtr = static_cast<uint8_t*>(data.ArrayBuffer().Data()) + data.ByteOffset();
-            size_t dataSize = data.ByteLength();
+        if (!texture->IsValid())
+        {
+            throw Napi::Error::New(Env(), "Cannot update a texture 2D array that has not been loaded");
+        }
 
-            size_t textureSize = dataSize / static_cast<size_t>(depth);
+        UpdateRawTexture2DArrayLayers(texture, data, format, firstLayer, dataHasMips, invertY);
+    }
 
-            for (uint16_t i = 0; i < depth; i++)
-            {
-                uint8_t* begin = dataPtr + (textureSize * static_cast<size_t>(i));
-                const bgfx::Memory* dataCopy = bgfx::copy(begin, static_cast<uint32_t>(textureSize)); // This is required since BGFX must manage the data the memory.
-                texture->Update2D(i, 0, 0, 0, width, height, dataCopy);
-            }
+    void NativeEngine::UpdateRawTexture2DArrayLayers(Graphics::Texture* texture, Napi::TypedArray data, bimg::TextureFormat::Enum format, uint16_t firstLayer, bool dataHasMips, bool invertY)
+    {
+        const auto dataSpan{gsl::make_span(static_cast<const uint8_t*>(data.ArrayBuffer().Data()) + data.ByteOffset(), data.ByteLength())};
+
+        try
+        {
+            UpdateTexture2DArrayLayers(texture, dataSpan, format, firstLayer, dataHasMips, invertY);
         }
+        catch (const std::exception& exception)
+        {
+            throw Napi::Error::New(Env(), exception.what());
+        }
+    }
+
+    void NativeEngine::UpdateTexture(const Napi::CallbackInfo& info)
+    {
+        const auto texture{info[0].As<Napi::Pointer<Graphics::Texture>>().Get()};
+        const auto data{info[1].As<Napi::TypedArray>()};
+        const auto x{static_cast<uint16_t>(info[2].As<Napi::Number>().Uint32Value())};
+        const auto y{static_cast<uint16_t>(info[3].As<Napi::Number>().Uint32Value())};
+        const auto width{static_cast<uint16_t>(info[4].As<Napi::Number>().Uint32Value())};
+        const auto height{static_cast<uint16_t>(info[5].As<Napi::Number>().Uint32Value())};
+        const auto mip{static_cast<uint8_t>(info[6].As<Napi::Number>().Uint32Value())};
+        const auto layer{static_cast<uint16_t>(info[7].As<Napi::Number>().Uint32Value())};
+        const auto face{static_cast<uint8_t>(info[8].IsUndefined() ? 0 : info[8].As<Napi::Number>().Uint32Value())};
+        const auto format{static_cast<bimg::TextureFormat::Enum>(texture->Format())};
+
+        texture->MakeResidentNow();
+        if (!texture->IsValid())
+        {
+            throw Napi::Error::New(Env(), "Cannot update a texture that has not been loaded");
+        }
+
+        const uint8_t numMips{texture->HasMips() ? bimg::imageGetNumMips(format, texture->Width(), texture->Height()) : uint8_t{1}};
+        if (mip >= numMips)
+        {
+            throw Napi::Error::New(Env(), "The mip level is outside of the texture");
+        }
+
+        if (layer >= std::max<uint16_t>(texture->NumLayers(), 1) || (texture->IsCubeMap() ? face >= 6 : face != 0))
+        {
+            throw Napi::Error::New(Env(), "The layer or face is outside of the texture");
+        }
+
+        const auto mipWidth{static_cast<uint16_t>(std::max(1, texture->Width() >> mip))};
+        const auto mipHeight{static_cast<uint16_t>(std::max(1, texture->Height() >> mip))};
+        if (static_cast<uint32_t>(x) + width > mipWidth || static_cast<uint32_t>(y) + height > mipHeight)
+        {
+            throw Napi::Error::New(Env(), "The region is outside of the texture mip level");
+        }
+
+        if (width == 0 || height == 0)
+        {
+            return;
+        }
+
+        // Block compressed formats are updated in whole blocks, so the region must start on a block boundary and either
+        // cover whole blocks or reach the edge of the mip level. Uncompressed formats have 1x1 blocks.
+        const bimg::ImageBlockInfo& blockInfo{bimg::getBlockInfo(format)};
+        if (x % blockInfo.blockWidth != 0 || y % blockInfo.blockHeight != 0 ||
+            (width % blockInfo.blockWidth != 0 && x + width != mipWidth) ||
+            (height % blockInfo.blockHeight != 0 && y + height != mipHeight))
+        {
+            throw Napi::Error::New(Env(), "The region is not aligned to the blocks of the texture format");
+        }
+
+        // Rows are rows of blocks. A row pitch of 0 means the rows are tightly packed.
+        const uint32_t rowSize{bimg::imageGetSize(nullptr, width, blockInfo.blockHeight, 1, false, false, 1, format)};
+        const uint32_t rowCount{(static_cast<uint32_t>(height) + blockInfo.blockHeight - 1) / blockInfo.blockHeight};
+        const uint32_t rowPitch{info[9].IsUndefined() || info[9].As<Napi::Number>().Uint32Value() == 0 ? rowSize : info[9].As<Napi::Number>().Uint32Value()};
+        if (rowPitch < rowSize || rowPitch > UINT16_MAX)
+        {
+            throw Napi::Error::New(Env(), "Invalid row pitch");
+        }
+
+        // The last row doesn't need to be padded to the row pitch.
+        const uint32_t regionSize{rowPitch * (rowCount - 1) + rowSize};
+        if (data.ByteLength() < regionSize)
+        {
+            throw Napi::Error::New(Env(), "The data size is too small for the region and row pitch");
+        }
+
+        // The restore callback only knows the original contents, so a partially updated texture can no longer be evicted.
+        texture->SetRestoreCallback({});
+
+        // The data is copied, as JavaScript may reuse the buffer before the frame is rendered.
+        const bgfx::Memory* mem{bgfx::copy(static_cast<const uint8_t*>(data.ArrayBuffer().Data()) + data.ByteOffset(), regionSize)};
+        if (texture->IsCubeMap())
+        {
+            texture->UpdateCube(layer, face, mip, x, y, width, height, mem, static_cast<uint16_t>(rowPitch));
+        }
+        else
+        {
+            texture->Update2D(layer, mip, x, y, width, height, mem, static_cast<uint16_t>(rowPitch));
+        }
+
+        const uint64_t uploadedBytes{static_cast<uint64_t>(rowSize) * rowCount};
+        const uint64_t mipBytes{bimg::imageGetSize(nullptr, mipWidth, mipHeight, 1, false, false, 1, format)};
+        m_deviceContext.AddTextureUploadStats(uploadedBytes, mipBytes > uploadedBytes ? mipBytes - uploadedBytes : 0);
     }
 
     void NativeEngine::LoadCubeTexture(const Napi::CallbackInfo& info)
@@ -1612,16 +1928,22 @@ namespace Babylon
         bgfx::Encoder* encoder = GetUpdateToken().GetEncoder();
 
         const UniformInfo* uniformInfo = data.ReadPointer<UniformInfo>();
-        const Graphics::Texture* texture = data.ReadPointer<Graphics::Texture>();
+        Graphics::Texture* texture = data.ReadPointer<Graphics::Texture>();
 
-        encoder->setTexture(uniformInfo->Stage, uniformInfo->Handle, texture->Handle(), texture->SamplerFlags());
+        // Evicted textures are restored in the background and sample the placeholder until they are resident again.
+        const bgfx::TextureHandle handle{texture->MakeResident() ? texture->Handle() : GetPlaceholderTexture()};
+        texture->Touch();
+
+        encoder->setTexture(uniformInfo->Stage, uniformInfo->Handle, handle, texture->SamplerFlags());
     }
 
     void NativeEngine::DeleteTexture(const Napi::CallbackInfo& info)
     {
         Graphics::Texture* texture = info[0].As<Napi::Pointer<Graphics::Texture>>().Get();
-        m_deviceContext.RemoveTexture(texture->Handle());
-        texture->Dispose();
+        if (!texture->IsShared())
+        {
+            texture->Dispose();
+        }
     }
 
     Napi::Value NativeEngine::ReadTexture(const Napi::CallbackInfo& info)
@@ -1640,6 +1962,9 @@ namespace Babylon
 
         const auto deferred{Napi::Promise::Deferred::New(env)};
 
+        texture->MakeResidentNow();
+        texture->Touch();
+
         // Calculate source texture storage size.
         const auto sourceTextureFormat{texture->Format()};
         bgfx::TextureInfo sourceTextureInfo{};
@@ -1672,87 +1997,287 @@ namespace Babylon
         else
         {
             bgfx::TextureHandle sourceTextureHandle{texture->Handle()};
-            auto tempTexture{false};
+            ReadbackTexture readbackTexture{};
 
             // If the image needs to be cropped (not starting at 0, or less than full width/height (accounting for requested mip level)),
-            // or if the texture was not created with the BGFX_TEXTURE_READ_BACK flag, then blit it to a temp texture.
+            // or if the texture was not created with the BGFX_TEXTURE_READ_BACK flag, then blit it to a pooled readback texture.
             if (x != 0 || y != 0 || width != (texture->Width() >> mipLevel) || height != (texture->Height() >> mipLevel) || (texture->Flags() & BGFX_TEXTURE_READ_BACK) == 0)
             {
-                const bgfx::TextureHandle blitTextureHandle{bgfx::createTexture2D(width, height, /*hasMips*/ false, /*numLayers*/ 1, sourceTextureFormat, BGFX_TEXTURE_BLIT_DST | BGFX_TEXTURE_READ_BACK)};
+                readbackTexture = AcquireReadbackTexture(width, height, sourceTextureFormat);
                 bgfx::Encoder* encoder{GetUpdateToken().GetEncoder()};
-                encoder->blit(static_cast<uint16_t>(bgfx::getCaps()->limits.maxViews - 1), blitTextureHandle, /*dstMip*/ 0, /*dstX*/ 0, /*dstY*/ 0, /*dstZ*/ 0, sourceTextureHandle, mipLevel, x, y, /*srcZ*/ 0, width, height, /*depth*/ 0);
+                encoder->blit(Graphics::DeviceContext::GetBlitViewId(), readbackTexture.Handle, /*dstMip*/ 0, /*dstX*/ 0, /*dstY*/ 0, /*dstZ*/ 0, sourceTextureHandle, mipLevel, x, y, /*srcZ*/ 0, width, height, /*depth*/ 0);
 
-                sourceTextureHandle = blitTextureHandle;
-                tempTexture = true;
+                sourceTextureHandle = readbackTexture.Handle;
 
                 // The requested mip level was blitted, so the source texture now has just one mip, so reset the mip level to 0.
                 mipLevel = 0;
             }
 
-            // Allocate a buffer to store the source pixel data.
-            std::vector<uint8_t> textureBuffer(sourceTextureInfo.storageSize);
-
-            // Read the source texture.
-            m_deviceContext.ReadTextureAsync(sourceTextureHandle, textureBuffer, mipLevel)
-                .then(arcana::inline_scheduler, *m_cancellationSource, [textureBuffer{std::move(textureBuffer)}, sourceTextureInfo, targetTextureInfo]() mutable {
-                    // If the source texture format does not match the target texture format, convert it.
-                    if (targetTextureInfo.format != sourceTextureInfo.format)
+            // Read straight into the JS buffer when no conversion is needed, otherwise into a pooled staging buffer
+            // that is converted into the JS buffer. The JS buffer is kept alive by the final continuation.
+            uint8_t* destination{static_cast<uint8_t*>(buffer.Data()) + bufferOffset};
+            const bool direct{sourceTextureInfo.format == targetTextureInfo.format};
+            std::vector<uint8_t> stagingBuffer{direct ? std::vector<uint8_t>{} : AcquireReadbackBuffer(sourceTextureInfo.storageSize)};
+            const gsl::span<uint8_t> readDestination{direct ? gsl::make_span(destination, sourceTextureInfo.storageSize) : gsl::make_span(stagingBuffer)};
+
+            m_deviceContext.ReadTextureAsync(sourceTextureHandle, readDestination, mipLevel)
+                .then(arcana::inline_scheduler, *m_cancellationSource, [destination, readDestination, direct, sourceTextureInfo, targetTextureInfo]() {
+                    // If the source texture format does not match the target texture format, convert it into the JS buffer.
+                    if (!direct)
                     {
-                        std::vector<uint8_t> convertedTextureBuffer(targetTextureInfo.storageSize);
-                        if (!bimg::imageConvert(&Graphics::DeviceContext::GetDefaultAllocator(), convertedTextureBuffer.data(), bimg::TextureFormat::Enum(targetTextureInfo.format), textureBuffer.data(), bimg::TextureFormat::Enum(sourceTextureInfo.format), sourceTextureInfo.width, sourceTextureInfo.height, /*depth*/ 1))
+                        if (!bimg::imageConvert(&Graphics::DeviceContext::GetDefaultAllocator(), destination, bimg::TextureFormat::Enum(targetTextureInfo.format), readDestination.data(), bimg::TextureFormat::Enum(sourceTextureInfo.format), sourceTextureInfo.width, sourceTextureInfo.height, /*depth*/ 1))
                         {
                             throw std::runtime_error{"Texture conversion to RBGA8 failed."};
                         }
-                        textureBuffer = convertedTextureBuffer;
                     }
 
-                    // Ensure the final texture buffer has the expected size.
-                    assert(textureBuffer.size() == targetTextureInfo.storageSize);
-
                     // Flip the image vertically if needed.
                     if (bgfx::getCaps()->originBottomLeft)
                     {
-                        FlipImage(textureBuffer, targetTextureInfo.height);
+                        FlipImage({destination, targetTextureInfo.storageSize}, targetTextureInfo.height);
                     }
-
-                    return textureBuffer;
                 })
-                .then(m_runtimeScheduler, *m_cancellationSource, [this, bufferRef{Napi::Persistent(buffer)}, bufferOffset, deferred, tempTexture, sourceTextureHandle](std::vector<uint8_t> textureBuffer) mutable {
-                    // Double check the destination buffer length. This is redundant with prior checks, but we'll be extra sure before the memcpy.
-                    assert(bufferRef.Value().ByteLength() - bufferOffset >= textureBuffer.size());
-
-                    // Copy the pixel data into the JS ArrayBuffer.
-                    uint8_t* buffer{static_cast<uint8_t*>(bufferRef.Value().Data())};
-                    std::memcpy(buffer + bufferOffset, textureBuffer.data(), textureBuffer.size());
-
-                    // Dispose of the texture handle before resolving the promise.
-                    // TODO: Handle properly handle stale handles after BGFX shutdown
-                    if (tempTexture && !m_cancellationSource->cancelled())
+                .then(m_runtimeScheduler, arcana::cancellation::none(), [this, env, bufferRef{Napi::Persistent(buffer)}, deferred, readbackTexture, stagingBuffer{std::move(stagingBuffer)}, cancellationSource{m_cancellationSource}, &deviceContext{m_deviceContext}](const arcana::expected<void, std::exception_ptr>& result) mutable {
+                    // Return the readback resources to the pools before resolving the promise.
+                    if (!cancellationSource->cancelled())
                     {
-                        bgfx::destroy(sourceTextureHandle);
-                        tempTexture = false;
-                    }
+                        if (bgfx::isValid(readbackTexture.Handle))
+                        {
+                            ReleaseReadbackTexture(readbackTexture);
+                        }
 
-                    deferred.Resolve(bufferRef.Value());
-                })
-                .then(m_runtimeScheduler, arcana::cancellation::none(), [this, env, deferred, tempTexture, sourceTextureHandle](const arcana::expected<void, std::exception_ptr>& result) {
-                    // Dispose of the texture handle if not yet disposed.
-                    // TODO: Handle properly handle stale handles after BGFX shutdown
-                    if (tempTexture && !m_cancellationSource->cancelled())
+                        ReleaseReadbackBuffer(std::move(stagingBuffer));
+                    }
+                    else if (bgfx::isValid(readbackTexture.Handle) && readbackTexture.DeviceId == deviceContext.GetDeviceId())
                     {
-                        bgfx::destroy(sourceTextureHandle);
+                        // The engine was disposed while the readback was in flight, so its pool is gone.
+                        bgfx::destroy(readbackTexture.Handle);
                     }
 
                     if (result.has_error())
                     {
                         deferred.Reject(Napi::Error::New(env, result.error()).Value());
                     }
+                    else
+                    {
+                        deferred.Resolve(bufferRef.Value());
+                    }
                 });
         }
 
         return deferred.Promise();
     }
 
+    Napi::Value NativeEngine::GetFrameStats(const Napi::CallbackInfo& info)
+    {
+        const auto stats{m_deviceContext.GetFrameStats()};
+
+        auto jsStats{Napi::Object::New(info.Env())};
+        jsStats.Set("textureBytesUploaded", Napi::Value::From(info.Env(), static_cast<double>(stats.TextureBytesUploaded)));
+        jsStats.Set("textureBytesSaved", Napi::Value::From(info.Env(), static_cast<double>(stats.TextureBytesSaved)));
+        jsStats.Set("viewsUsed", Napi::Value::From(info.Env(), stats.ViewsUsed));
+        jsStats.Set("viewsOverflowed", Napi::Value::From(info.Env(), stats.ViewsOverflowed));
+        jsStats.Set("frameTime", Napi::Value::From(info.Env(), stats.FrameTime));
+        jsStats.Set("frameTimeJitter", Napi::Value::From(info.Env(), stats.FrameTimeJitter));
+        jsStats.Set("canvasDrawCalls", Napi::Value::From(info.Env(), stats.CanvasDrawCalls));
+        jsStats.Set("canvasUnbatchedDrawCalls", Napi::Value::From(info.Env(), stats.CanvasUnbatchedDrawCalls));
+        jsStats.Set("canvasVertices", Napi::Value::From(info.Env(), stats.CanvasVertices));
+        jsStats.Set("canvasTransientOverflows", Napi::Value::From(info.Env(), stats.CanvasTransientOverflows));
+        return std::move(jsStats);
+    }
+
+    bgfx::TextureHandle NativeEngine::GetPlaceholderTexture()
+    {
+        // The placeholder is recreated after a device reset, where the old handle is stale.
+        const auto deviceId{m_deviceContext.GetDeviceId()};
+        if (!bgfx::isValid(m_placeholderTexture) || m_placeholderTextureDeviceId != deviceId)
+        {
+            constexpr uint32_t opaqueBlack{0xFF000000};
+            m_placeholderTexture = bgfx::createTexture2D(1, 1, false, 1, bgfx::TextureFormat::RGBA8, BGFX_TEXTURE_NONE, bgfx::copy(&opaqueBlack, sizeof(opaqueBlack)));
+            m_placeholderTextureDeviceId = deviceId;
+        }
+
+        return m_placeholderTexture;
+    }
+
+    NativeEngine::ReadbackTexture NativeEngine::AcquireReadbackTexture(uint16_t width, uint16_t height, bgfx::TextureFormat::Enum format)
+    {
+        const auto deviceId{m_deviceContext.GetDeviceId()};
+
+        // Handles from before a device reset are stale and are dropped without being destroyed.
+        m_readbackTextures.erase(std::remove_if(m_readbackTextures.begin(), m_readbackTextures.end(), [deviceId](const ReadbackTexture& texture) {
+            return texture.DeviceId != deviceId;
+        }), m_readbackTextures.end());
+
+        auto it{std::find_if(m_readbackTextures.begin(), m_readbackTextures.end(), [width, height, format](const ReadbackTexture& texture) {
+            return texture.Width == width && texture.Height == height && texture.Format == format;
+        })};
+
+        if (it != m_readbackTextures.end())
+        {
+            ReadbackTexture texture{*it};
+            m_readbackTextures.erase(it);
+            return texture;
+        }
+
+        return {bgfx::createTexture2D(width, height, /*hasMips*/ false, /*numLayers*/ 1, format, BGFX_TEXTURE_BLIT_DST | BGFX_TEXTURE_READ_BACK), width, height, format, deviceId};
+    }
+
+    void NativeEngine::ReleaseReadbackTexture(ReadbackTexture texture)
+    {
+        if (texture.DeviceId != m_deviceContext.GetDeviceId())
+        {
+            return;
+        }
+
+        m_readbackTextures.push_back(texture);
+
+        // Keep only the most recently used readback textures.
+        if (m_readbackTextures.size() > MAX_IDLE_READBACK_TEXTURES)
+        {
+            bgfx::destroy(m_readbackTextures.front().Handle);
+            m_readbackTextures.erase(m_readbackTextures.begin());
+        }
+    }
+
+    std::vector<uint8_t> NativeEngine::AcquireReadbackBuffer(size_t size)
+    {
+        std::vector<uint8_t> buffer{};
+        if (!m_readbackBuffers.empty())
+        {
+            buffer = std::move(m_readbackBuffers.back());
+            m_readbackBuffers.pop_back();
+        }
+
+        buffer.resize(size);
+        return buffer;
+    }
+
+    void NativeEngine::ReleaseReadbackBuffer(std::vector<uint8_t> buffer)
+    {
+        if (buffer.capacity() != 0 && m_readbackBuffers.size() < MAX_IDLE_READBACK_TEXTURES)
+        {
+            m_readbackBuffers.push_back(std::move(buffer));
+        }
+    }
+
+    Napi::Value NativeEngine::GetTextureMemoryStats(const Napi::CallbackInfo& info)
+    {
+        const auto stats{m_deviceContext.GetTextureMemoryStats()};
+
+        auto jsStats{Napi::Object::New(info.Env())};
+        jsStats.Set("usage", Napi::Value::From(info.Env(), static_cast<double>(stats.Usage)));
+        jsStats.Set("budget", Napi::Value::From(info.Env(), static_cast<double>(stats.Budget)));
+        jsStats.Set("evictionCount", Napi::Value::From(info.Env(), static_cast<double>(stats.EvictionCount)));
+        return std::move(jsStats);
+    }
+
+    void NativeEngine::SetTextureMemoryBudget(const Napi::CallbackInfo& info)
+    {
+        const auto bytes{info[0].As<Napi::Number>().DoubleValue()};
+        if (bytes < 0)
+        {
+            throw Napi::Error::New(info.Env(), "Texture memory budget cannot be negative.");
+        }
+
+        m_deviceContext.SetTextureMemoryBudget(static_cast<size_t>(bytes));
+    }
+
+    Napi::Value NativeEngine::CreateTextureAtlas(const Napi::CallbackInfo& info)
+    {
+        const auto maxTextureSize{static_cast<uint16_t>(bgfx::getCaps()->limits.maxTextureSize)};
+        const auto pageSize{info[0].IsUndefined() ? std::min<uint16_t>(2048, maxTextureSize) : static_cast<uint16_t>(info[0].As<Napi::Number>().Uint32Value())};
+        if (pageSize > maxTextureSize)
+        {
+            throw Napi::Error::New(info.Env(), "Texture atlas page size exceeds the maximum texture size");
+        }
+
+        TextureAtlas* atlas{};
+        try
+        {
+            atlas = new TextureAtlas{m_deviceContext, pageSize};
+        }
+        catch (const std::exception& exception)
+        {
+            throw Napi::Error::New(info.Env(), exception.what());
+        }
+
+        return Napi::Pointer<TextureAtlas>::Create(info.Env(), atlas, Napi::NapiPointerDeleter(atlas));
+    }
+
+    Napi::Value NativeEngine::AddToTextureAtlas(const Napi::CallbackInfo& info)
+    {
+        auto* atlas{info[0].As<Napi::Pointer<TextureAtlas>>().Get()};
+        const auto data{info[1].As<Napi::TypedArray>()};
+        const auto width{static_cast<uint16_t>(info[2].As<Napi::Number>().Uint32Value())};
+        const auto height{static_cast<uint16_t>(info[3].As<Napi::Number>().Uint32Value())};
+
+        const auto dataSpan{gsl::make_span(static_cast<const uint8_t*>(data.ArrayBuffer().Data()) + data.ByteOffset(), data.ByteLength())};
+
+        try
+        {
+            const uint32_t id{atlas->Add(dataSpan, width, height)};
+            return CreateTextureAtlasRegion(info.Env(), id, atlas->GetRegion(id));
+        }
+        catch (const std::exception& exception)
+        {
+            throw Napi::Error::New(info.Env(), exception.what());
+        }
+    }
+
+    void NativeEngine::RemoveFromTextureAtlas(const Napi::CallbackInfo& info)
+    {
+        auto* atlas{info[0].As<Napi::Pointer<TextureAtlas>>().Get()};
+        const auto id{info[1].As<Napi::Number>().Uint32Value()};
+        atlas->Remove(id);
+    }
+
+    Napi::Value NativeEngine::GetTextureAtlasRegion(const Napi::CallbackInfo& info)
+    {
+        const auto* atlas{info[0].As<Napi::Pointer<TextureAtlas>>().Get()};
+        const auto id{info[1].As<Napi::Number>().Uint32Value()};
+
+        try
+        {
+            return CreateTextureAtlasRegion(info.Env(), id, atlas->GetRegion(id));
+        }
+        catch (const std::exception& exception)
+        {
+            throw Napi::Error::New(info.Env(), exception.what());
+        }
+    }
+
+    Napi::Value NativeEngine::GetTextureAtlasFragmentation(const Napi::CallbackInfo& info)
+    {
+        const auto* atlas{info[0].As<Napi::Pointer<TextureAtlas>>().Get()};
+        return Napi::Value::From(info.Env(), atlas->GetFragmentation());
+    }
+
+    Napi::Value NativeEngine::CompactTextureAtlas(const Napi::CallbackInfo& info)
+    {
+        auto* atlas{info[0].As<Napi::Pointer<TextureAtlas>>().Get()};
+
+        const auto deferred{Napi::Promise::Deferred::New(info.Env())};
+
+        // Pack and compose the new pages on a background thread, then swap them in on the JavaScript thread.
+        // Regions change once the promise resolves, so they must be queried again with getTextureAtlasRegion.
+        auto plan{atlas->BeginCompaction()};
+        arcana::make_task(arcana::threadpool_scheduler, *m_cancellationSource, [plan]() {
+            TextureAtlas::BuildCompaction(*plan);
+        }).then(m_runtimeScheduler, *m_cancellationSource, [atlas, plan, atlasRef{Napi::Persistent(info[0])}, deferred, cancellationSource{m_cancellationSource}](const arcana::expected<void, std::exception_ptr>& result) {
+            if (result.has_error())
+            {
+                deferred.Reject(Napi::Error::New(deferred.Env(), result.error()).Value());
+                return;
+            }
+
+            atlas->EndCompaction(*plan);
+            deferred.Resolve(deferred.Env().Undefined());
+        });
+
+        return deferred.Promise();
+    }
+
     Napi::Value NativeEngine::CreateFrameBuffer(const Napi::CallbackInfo& info)
     {
         Graphics::Texture* texture = info[0].IsNull() ? nullptr : info[0].As<Napi::Pointer<Graphics::Texture>>().Get();
@@ -1764,6 +2289,8 @@ namespace Babylon
 
         std::array<bgfx::Attachment, 2> attachments{};
         uint8_t numAttachments = 0;
+        bgfx::TextureHandle depthStencilTexture{bgfx::kInvalidHandle};
+        auto depthStencilFormat{bgfx::TextureFormat::Unknown};
 
         if (texture != nullptr)
         {
@@ -1779,14 +2306,15 @@ namespace Babylon
             }
 
             auto flags = BGFX_TEXTURE_RT_WRITE_ONLY | RenderTargetSamplesToBgfxMsaaFlag(samples);
-            const auto depthStencilFormat{generateStencilBuffer ? bgfx::TextureFormat::D24S8 : bgfx::TextureFormat::D32};
+            depthStencilFormat = generateStencilBuffer ? bgfx::TextureFormat::D24S8 : bgfx::TextureFormat::D32;
             assert(bgfx::isTextureValid(0, false, 1, depthStencilFormat, flags));
 
             // bgfx doesn't add flag D3D11_RESOURCE_MISC_GENERATE_MIPS for depth textures (missing that flag will crash D3D with resolving)
             // And not sure it makes sense to generate mipmaps from a depth buffer with exponential values.
             // only allows mipmaps resolve step when mipmapping is asked and for the color texture, not the depth.
             // https://github.com/bkaradzic/bgfx/blob/2c21f68998595fa388e25cb6527e82254d0e9bff/src/renderer_d3d11.cpp#L4525
-            attachments[numAttachments++].init(bgfx::createTexture2D(width, height, false, 1, depthStencilFormat, flags));
+            depthStencilTexture = bgfx::createTexture2D(width, height, false, 1, depthStencilFormat, flags);
+            attachments[numAttachments++].init(depthStencilTexture);
         }
 
         bgfx::FrameBufferHandle frameBufferHandle = bgfx::createFrameBuffer(numAttachments, attachments.data(), true);
@@ -1796,6 +2324,10 @@ namespace Babylon
         }
 
         Graphics::FrameBuffer* frameBuffer = new Graphics::FrameBuffer(m_deviceContext, frameBufferHandle, width, height, false, generateDepth, generateStencilBuffer);
+        if (bgfx::isValid(depthStencilTexture))
+        {
+            frameBuffer->TrackAttachment(depthStencilTexture, width, height, depthStencilFormat);
+        }
         return Napi::Pointer<Graphics::FrameBuffer>::Create(info.Env(), frameBuffer, Napi::NapiPointerDeleter(frameBuffer));
     }
 
@@ -1945,12 +2477,12 @@ namespace Babylon
 
     Napi::Value NativeEngine::GetRenderWidth(const Napi::CallbackInfo& info)
     {
-        return Napi::Value::From(info.Env(), std::floor(m_deviceContext.GetWidth() / m_deviceContext.GetHardwareScalingLevel()));
+        return Napi::Value::From(info.Env(), std::floor(m_deviceContext.GetWidth() / m_deviceContext.GetRenderScalingLevel()));
     }
 
     Napi::Value NativeEngine::GetRenderHeight(const Napi::CallbackInfo& info)
     {
-        return Napi::Value::From(info.Env(), std::floor(m_deviceContext.GetHeight() / m_deviceContext.GetHardwareScalingLevel()));
+        return Napi::Value::From(info.Env(), std::floor(m_deviceContext.GetHeight() / m_deviceContext.GetRenderScalingLevel()));
     }
 
     Napi::Value NativeEngine::GetHardwareScalingLevel(const Napi::CallbackInfo& info)
@@ -1964,6 +2496,35 @@ namespace Babylon
         m_deviceContext.SetHardwareScalingLevel(level);
     }
 
+    Napi::Value NativeEngine::GetRenderScale(const Napi::CallbackInfo& info)
+    {
+        return Napi::Value::From(info.Env(), m_deviceContext.GetRenderScale());
+    }
+
+    void NativeEngine::SetDynamicResolution(const Napi::CallbackInfo& info)
+    {
+        Graphics::DynamicResolutionConfiguration config{};
+        config.TargetFrameTime = info[0].As<Napi::Number>().FloatValue();
+        if (!info[1].IsUndefined())
+        {
+            config.MinScale = info[1].As<Napi::Number>().FloatValue();
+        }
+
+        if (!info[2].IsUndefined())
+        {
+            config.MaxScale = info[2].As<Napi::Number>().FloatValue();
+        }
+
+        try
+        {
+            m_deviceContext.SetDynamicResolution(config);
+        }
+        catch (const std::exception& exception)
+        {
+            throw Napi::Error::New(info.Env(), exception.what());
+        }
+    }
+
     Napi::Value NativeEngine::CreateImageBitmap(const Napi::CallbackInfo& info)
     {
         const Napi::Env env{info.Env()};
@@ -2089,9 +2650,11 @@ namespace Babylon
 
         auto callbackPtr{std::make_shared<Napi::FunctionReference>(Napi::Persistent(callback))};
         m_deviceContext.RequestScreenShot([this, callbackPtr{std::move(callbackPtr)}](std::vector<uint8_t> array) {
-            m_runtime.Dispatch([callbackPtr{std::move(callbackPtr)}, array{std::move(array)}](Napi::Env env) {
-                auto arrayBuffer{Napi::ArrayBuffer::New(env, const_cast<uint8_t*>(array.data()), array.size())};
-                auto typedArray{Napi::Uint8Array::New(env, array.size(), arrayBuffer, 0)};
+            m_runtime.Dispatch([callbackPtr{std::move(callbackPtr)}, array{std::move(array)}](Napi::Env env) mutable {
+                // Hand the converted screen shot over to JavaScript without copying it.
+                auto* data{new std::vector<uint8_t>{std::move(array)}};
+                auto arrayBuffer{Napi::ArrayBuffer::New(env, data->data(), data->size(), [data](Napi::Env, void*) { delete data; })};
+                auto typedArray{Napi::Uint8Array::New(env, data->size(), arrayBuffer, 0)};
                 callbackPtr->Value().Call({typedArray});
             });
         });
@@ -2288,6 +2851,8 @@ namespace Babylon
                 {
                     callback.Value().Call({});
                 }
+
+                m_deviceContext.EnforceTextureMemoryBudget();
             }).then(arcana::inline_scheduler, *m_cancellationSource, [this, cancellationSource{m_cancellationSource}](const arcana::expected<void, std::exception_ptr>& result) {
                 if (!cancellationSource->cancelled() && result.has_error())
                 {
@@ -3,6 +3,7 @@
 #include "NativeDataStream.h"
 #include "PerFrameValue.h"
 #include "ShaderCompiler.h"
+#include "TextureAtlas.h"
 #include "VertexArray.h"
 
 #include <Babylon/JsRuntime.h>
@@ -11,6 +12,7 @@
 #include <Babylon/Graphics/DeviceContext.h>
 #include <Babylon/Graphics/BgfxCallback.h>
 #include <Babylon/Graphics/FrameBuffer.h>
+#include <Babylon/Graphics/Texture.h>
 #include <Babylon/Graphics/DeviceContext.h>
 
 #include <napi/napi.h>
@@ -187,6 +189,9 @@ namespace Babylon
         void CopyTexture(const Napi::CallbackInfo& info);
         void LoadRawTexture(const Napi::CallbackInfo& info);
         void LoadRawTexture2DArray(const Napi::CallbackInfo& info);
+        void UpdateRawTexture2DArray(const Napi::CallbackInfo& info);
+        void UpdateRawTexture2DArrayLayers(Graphics::Texture* texture, Napi::TypedArray data, bimg::TextureFormat::Enum format, uint16_t firstLayer, bool dataHasMips, bool invertY);
+        void UpdateTexture(const Napi::CallbackInfo& info);
         void LoadCubeTexture(const Napi::CallbackInfo& info);
         void LoadCubeTextureWithMips(const Napi::CallbackInfo& info);
         Napi::Value GetTextureWidth(const Napi::CallbackInfo& info);
@@ -197,6 +202,15 @@ namespace Babylon
         void SetTexture(NativeDataStream::Reader& data);
         void DeleteTexture(const Napi::CallbackInfo& info);
         Napi::Value ReadTexture(const Napi::CallbackInfo& info);
+        Napi::Value GetTextureMemoryStats(const Napi::CallbackInfo& info);
+        Napi::Value GetFrameStats(const Napi::CallbackInfo& info);
+        Napi::Value CreateTextureAtlas(const Napi::CallbackInfo& info);
+        Napi::Value AddToTextureAtlas(const Napi::CallbackInfo& info);
+        void RemoveFromTextureAtlas(const Napi::CallbackInfo& info);
+        Napi::Value GetTextureAtlasRegion(const Napi::CallbackInfo& info);
+        Napi::Value GetTextureAtlasFragmentation(const Napi::CallbackInfo& info);
+        Napi::Value CompactTextureAtlas(const Napi::CallbackInfo& info);
+        void SetTextureMemoryBudget(const Napi::CallbackInfo& info);
         Napi::Value CreateFrameBuffer(const Napi::CallbackInfo& info);
         void DeleteFrameBuffer(NativeDataStream::Reader& data);
         void BindFrameBuffer(NativeDataStream::Reader& data);
@@ -210,6 +224,8 @@ namespace Babylon
         Napi::Value GetRenderHeight(const Napi::CallbackInfo& info);
         Napi::Value GetHardwareScalingLevel(const Napi::CallbackInfo& info);
         void SetHardwareScalingLevel(const Napi::CallbackInfo& info);
+        Napi::Value GetRenderScale(const Napi::CallbackInfo& info);
+        void SetDynamicResolution(const Napi::CallbackInfo& info);
         Napi::Value CreateImageBitmap(const Napi::CallbackInfo& info);
         Napi::Value ResizeImageBitmap(const Napi::CallbackInfo& info);
         void GetFrameBufferData(const Napi::CallbackInfo& info);
@@ -223,6 +239,29 @@ namespace Babylon
 
         std::string ProcessShaderCoordinates(const std::string& vertexSource);
 
+        struct ReadbackTexture
+        {
+            bgfx::TextureHandle Handle{bgfx::kInvalidHandle};
+            uint16_t Width{};
+            uint16_t Height{};
+            bgfx::TextureFormat::Enum Format{bgfx::TextureFormat::Unknown};
+            uintptr_t DeviceId{};
+        };
+
+        // Readback textures and staging buffers are pooled so that readbacks every frame don't create textures or allocate.
+        static constexpr size_t MAX_IDLE_READBACK_TEXTURES{4};
+        ReadbackTexture AcquireReadbackTexture(uint16_t width, uint16_t height, bgfx::TextureFormat::Enum format);
+        void ReleaseReadbackTexture(ReadbackTexture texture);
+        std::vector<uint8_t> AcquireReadbackBuffer(size_t size);
+        void ReleaseReadbackBuffer(std::vector<uint8_t> buffer);
+        std::vector<ReadbackTexture> m_readbackTextures{};
+        std::vector<std::vector<uint8_t>> m_readbackBuffers{};
+
+        // Bound in place of evicted textures while they are restored in the background.
+        bgfx::TextureHandle GetPlaceholderTexture();
+        bgfx::TextureHandle m_placeholderTexture{bgfx::kInvalidHandle};
+        uintptr_t m_placeholderTextureDeviceId{};
+
         Graphics::UpdateToken& GetUpdateToken();
         Graphics::FrameBuffer& GetBoundFrameBuffer(bgfx::Encoder& encoder);
 
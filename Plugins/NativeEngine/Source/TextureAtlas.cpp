@@ -0,0 +1,467 @@
+#include "TextureAtlas.h"
+
+#include <Babylon/Graphics/DeviceContext.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+
+namespace Babylon
+{
+    namespace
+    {
+        constexpr uint32_t BYTES_PER_PIXEL{4};
+
+        uint16_t AlignUp(uint32_t value, uint16_t alignment)
+        {
+            return static_cast<uint16_t>((value + alignment - 1) / alignment * alignment);
+        }
+
+        uint16_t MipSize(uint16_t size, uint8_t mip)
+        {
+            return static_cast<uint16_t>(std::max(1, size >> mip));
+        }
+
+        uint8_t GetNumMips(uint16_t size)
+        {
+            uint8_t numMips{1};
+            while ((size >> numMips) > 0)
+            {
+                ++numMips;
+            }
+
+            return numMips;
+        }
+
+        void CopyRect(const uint8_t* src, uint16_t srcWidth, uint16_t srcHeight, uint8_t* dst, uint16_t dstWidth, uint16_t dstX, uint16_t dstY)
+        {
+            const size_t rowSize{static_cast<size_t>(srcWidth) * BYTES_PER_PIXEL};
+            for (uint16_t row = 0; row < srcHeight; ++row)
+            {
+                std::memcpy(dst + ((static_cast<size_t>(dstY + row) * dstWidth) + dstX) * BYTES_PER_PIXEL, src + row * rowSize, rowSize);
+            }
+        }
+
+        const bgfx::Memory* MakeMemory(std::vector<uint8_t> bytes)
+        {
+            auto* bytesPtr = new std::vector<uint8_t>{std::move(bytes)};
+            return bgfx::makeRef(bytesPtr->data(), static_cast<uint32_t>(bytesPtr->size()), [](void*, void* userData) {
+                delete static_cast<std::vector<uint8_t>*>(userData);
+            }, bytesPtr);
+        }
+    }
+
+    SkylinePacker::SkylinePacker(uint16_t width, uint16_t height)
+        : m_width{width}
+        , m_height{height}
+    {
+        Reset();
+    }
+
+    void SkylinePacker::Reset()
+    {
+        m_skyline.clear();
+        m_skyline.push_back(Node{0, 0, m_width});
+    }
+
+    bool SkylinePacker::Fits(size_t index, uint16_t width, uint16_t height, uint16_t& y) const
+    {
+        if (static_cast<uint32_t>(m_skyline[index].X) + width > m_width)
+        {
+            return false;
+        }
+
+        // The rectangle rests on the highest node it spans.
+        y = 0;
+        uint32_t remaining{width};
+        for (size_t i = index; remaining > 0; ++i)
+        {
+            assert(i < m_skyline.size());
+            y = std::max(y, m_skyline[i].Y);
+            if (static_cast<uint32_t>(y) + height > m_height)
+            {
+                return false;
+            }
+
+            remaining -= std::min<uint32_t>(remaining, m_skyline[i].Width);
+        }
+
+        return true;
+    }
+
+    bool SkylinePacker::Pack(uint16_t width, uint16_t height, uint16_t& x, uint16_t& y)
+    {
+        size_t bestIndex{m_skyline.size()};
+        uint32_t bestTop{UINT32_MAX};
+        uint16_t bestWidth{UINT16_MAX};
+
+        // Bottom-left heuristic: lowest resulting top edge, then narrowest node.
+        for (size_t i = 0; i < m_skyline.size(); ++i)
+        {
+            uint16_t nodeY{};
+            if (Fits(i, width, height, nodeY))
+            {
+                const uint32_t top{static_cast<uint32_t>(nodeY) + height};
+                if (top < bestTop || (top == bestTop && m_skyline[i].Width < bestWidth))
+                {
+                    bestIndex = i;
+                    bestTop = top;
+                    bestWidth = m_skyline[i].Width;
+                    y = nodeY;
+                }
+            }
+        }
+
+        if (bestIndex == m_skyline.size())
+        {
+            return false;
+        }
+
+        x = m_skyline[bestIndex].X;
+
+        // Insert the new node and shrink or remove the nodes it now covers.
+        m_skyline.insert(m_skyline.begin() + bestIndex, Node{x, static_cast<uint16_t>(y + height), width});
+        for (size_t i = bestIndex + 1; i < m_skyline.size();)
+        {
+            const uint32_t previousEnd{static_cast<uint32_t>(m_skyline[i - 1].X) + m_skyline[i - 1].Width};
+            if (m_skyline[i].X >= previousEnd)
+            {
+                break;
+            }
+
+            const uint32_t shrink{previousEnd - m_skyline[i].X};
+            if (m_skyline[i].Width <= shrink)
+            {
+                m_skyline.erase(m_skyline.begin() + i);
+                continue;
+            }
+
+            m_skyline[i].X = static_cast<uint16_t>(m_skyline[i].X + shrink);
+            m_skyline[i].Width = static_cast<uint16_t>(m_skyline[i].Width - shrink);
+            break;
+        }
+
+        // Merge neighboring nodes at the same height.
+        for (size_t i = 0; i + 1 < m_skyline.size();)
+        {
+            if (m_skyline[i].Y == m_skyline[i + 1].Y)
+            {
+                m_skyline[i].Width = static_cast<uint16_t>(m_skyline[i].Width + m_skyline[i + 1].Width);
+                m_skyline.erase(m_skyline.begin() + i + 1);
+            }
+            else
+            {
+                ++i;
+            }
+        }
+
+        return true;
+    }
+
+    TextureAtlas::TextureAtlas(Graphics::DeviceContext& deviceContext, uint16_t pageSize)
+        : m_deviceContext{deviceContext}
+        , m_pageSize{pageSize}
+        , m_numMips{GetNumMips(pageSize)}
+    {
+        if (pageSize < ALIGNMENT || (pageSize & (pageSize - 1)) != 0)
+        {
+            throw std::runtime_error{"Texture atlas page size must be a power of two"};
+        }
+    }
+
+    uint32_t TextureAtlas::Add(gsl::span<const uint8_t> rgba, uint16_t width, uint16_t height)
+    {
+        if (width == 0 || height == 0 || rgba.size() != static_cast<size_t>(width) * height * BYTES_PER_PIXEL)
+        {
+            throw std::runtime_error{"The data size does not match width and height"};
+        }
+
+        if (AlignUp(width + 2u * GUTTER, ALIGNMENT) > m_pageSize || AlignUp(height + 2u * GUTTER, ALIGNMENT) > m_pageSize)
+        {
+            throw std::runtime_error{"Image is too large for the texture atlas"};
+        }
+
+        Entry entry{BuildPaddedImage(rgba, width, height, m_numMips), width, height};
+        Place(entry);
+        Upload(entry);
+
+        const uint32_t id{m_nextId++};
+        m_entries.emplace(id, std::move(entry));
+        return id;
+    }
+
+    void TextureAtlas::Remove(uint32_t id)
+    {
+        auto it{m_entries.find(id)};
+        if (it == m_entries.end())
+        {
+            return;
+        }
+
+        Page& page{m_pages[it->second.Page]};
+        page.UsedArea -= static_cast<size_t>(it->second.Image->Width) * it->second.Image->Height;
+
+        // An empty page can be reused right away without compacting.
+        if (--page.EntryCount == 0)
+        {
+            page.Packer.Reset();
+            page.UsedArea = 0;
+        }
+
+        m_entries.erase(it);
+    }
+
+    TextureAtlas::Region TextureAtlas::GetRegion(uint32_t id) const
+    {
+        auto it{m_entries.find(id)};
+        if (it == m_entries.end())
+        {
+            throw std::runtime_error{"Invalid texture atlas entry"};
+        }
+
+        const Entry& entry{it->second};
+        const float scale{1.0f / m_pageSize};
+        return {
+            m_pages[entry.Page].Texture,
+            (entry.X + GUTTER) * scale,
+            (entry.Y + GUTTER) * scale,
+            (entry.X + GUTTER + entry.ImageWidth) * scale,
+            (entry.Y + GUTTER + entry.ImageHeight) * scale};
+    }
+
+    float TextureAtlas::GetFragmentation() const
+    {
+        if (m_pages.empty())
+        {
+            return 0.0f;
+        }
+
+        size_t usedArea{};
+        for (const auto& page : m_pages)
+        {
+            usedArea += page.UsedArea;
+        }
+
+        const size_t totalArea{m_pages.size() * m_pageSize * m_pageSize};
+        return 1.0f - static_cast<float>(usedArea) / totalArea;
+    }
+
+    std::shared_ptr<TextureAtlas::CompactionPlan> TextureAtlas::BeginCompaction() const
+    {
+        auto plan{std::make_shared<CompactionPlan>()};
+        plan->PageSize = m_pageSize;
+        plan->NumMips = m_numMips;
+        plan->Items.reserve(m_entries.size());
+        for (const auto& [id, entry] : m_entries)
+        {
+            plan->Items.push_back({id, entry.Image});
+        }
+
+        return plan;
+    }
+
+    void TextureAtlas::BuildCompaction(CompactionPlan& plan)
+    {
+        // Packing tallest first gives a much flatter skyline.
+        std::sort(plan.Items.begin(), plan.Items.end(), [](const auto& a, const auto& b) {
+            return a.Image->Height > b.Image->Height;
+        });
+
+        for (auto& item : plan.Items)
+        {
+            bool placed{};
+            for (size_t page = 0; page < plan.Packers.size() && !placed; ++page)
+            {
+                placed = plan.Packers[page].Pack(item.Image->Width, item.Image->Height, item.X, item.Y);
+                item.Page = page;
+            }
+
+            if (!placed)
+            {
+                plan.Packers.emplace_back(plan.PageSize, plan.PageSize);
+                item.Page = plan.Packers.size() - 1;
+                placed = plan.Packers.back().Pack(item.Image->Width, item.Image->Height, item.X, item.Y);
+                assert(placed);
+            }
+        }
+
+        plan.Pages.resize(plan.Packers.size());
+        for (auto& page : plan.Pages)
+        {
+            page.resize(plan.NumMips);
+            for (uint8_t mip = 0; mip < plan.NumMips; ++mip)
+            {
+                const uint16_t size{MipSize(plan.PageSize, mip)};
+                page[mip].resize(static_cast<size_t>(size) * size * BYTES_PER_PIXEL);
+            }
+        }
+
+        for (const auto& item : plan.Items)
+        {
+            for (uint8_t mip = 0; mip < plan.NumMips; ++mip)
+            {
+                CopyRect(item.Image->Mips[mip].data(), MipSize(item.Image->Width, mip), MipSize(item.Image->Height, mip),
+                    plan.Pages[item.Page][mip].data(), MipSize(plan.PageSize, mip), static_cast<uint16_t>(item.X >> mip), static_cast<uint16_t>(item.Y >> mip));
+            }
+        }
+    }
+
+    void TextureAtlas::EndCompaction(CompactionPlan& plan)
+    {
+        std::vector<Page> pages{};
+        pages.reserve(plan.Packers.size());
+        for (size_t index = 0; index < plan.Packers.size(); ++index)
+        {
+            auto texture{CreatePage()};
+            for (uint8_t mip = 0; mip < plan.NumMips; ++mip)
+            {
+                const uint16_t size{MipSize(plan.PageSize, mip)};
+                texture->Update2D(0, mip, 0, 0, size, size, MakeMemory(std::move(plan.Pages[index][mip])));
+            }
+
+            pages.push_back({std::move(texture), std::move(plan.Packers[index])});
+        }
+
+        // Entries removed while compacting leave a hole until the next compaction, but are not counted as used.
+        for (const auto& item : plan.Items)
+        {
+            auto it{m_entries.find(item.Id)};
+            if (it == m_entries.end())
+            {
+                continue;
+            }
+
+            Page& page{pages[item.Page]};
+            page.UsedArea += static_cast<size_t>(item.Image->Width) * item.Image->Height;
+            page.EntryCount++;
+
+            it->second.Page = item.Page;
+            it->second.X = item.X;
+            it->second.Y = item.Y;
+        }
+
+        // Entries added while compacting are not part of the plan and are placed into the new pages.
+        std::vector<uint32_t> added{};
+        for (const auto& [id, entry] : m_entries)
+        {
+            const bool planned{std::any_of(plan.Items.begin(), plan.Items.end(), [id = id](const auto& item) { return item.Id == id; })};
+            if (!planned)
+            {
+                added.push_back(id);
+            }
+        }
+
+        m_pages = std::move(pages);
+
+        for (const uint32_t id : added)
+        {
+            Entry& entry{m_entries[id]};
+            Place(entry);
+            Upload(entry);
+        }
+    }
+
+    std::shared_ptr<const TextureAtlas::PaddedImage> TextureAtlas::BuildPaddedImage(gsl::span<const uint8_t> rgba, uint16_t width, uint16_t height, uint8_t numMips)
+    {
+        auto image{std::make_shared<PaddedImage>()};
+        image->Width = AlignUp(width + 2u * GUTTER, ALIGNMENT);
+        image->Height = AlignUp(height + 2u * GUTTER, ALIGNMENT);
+        image->Mips.resize(numMips);
+
+        // Copy the image into the middle and replicate its edge pixels into the gutter.
+        auto& base{image->Mips[0]};
+        base.resize(static_cast<size_t>(image->Width) * image->Height * BYTES_PER_PIXEL);
+        for (uint16_t y = 0; y < image->Height; ++y)
+        {
+            const int srcY{std::clamp(y - static_cast<int>(GUTTER), 0, height - 1)};
+            for (uint16_t x = 0; x < image->Width; ++x)
+            {
+                const int srcX{std::clamp(x - static_cast<int>(GUTTER), 0, width - 1)};
+                std::memcpy(&base[(static_cast<size_t>(y) * image->Width + x) * BYTES_PER_PIXEL], &rgba[(static_cast<size_t>(srcY) * width + srcX) * BYTES_PER_PIXEL], BYTES_PER_PIXEL);
+            }
+        }
+
+        // Box filter the mip chain. Sizes are aligned, so the first SAFE_MIP_LEVELS levels divide evenly.
+        for (uint8_t mip = 1; mip < numMips; ++mip)
+        {
+            const auto& src{image->Mips[mip - 1]};
+            const uint16_t srcWidth{MipSize(image->Width, mip - 1)};
+            const uint16_t srcHeight{MipSize(image->Height, mip - 1)};
+            const uint16_t dstWidth{MipSize(image->Width, mip)};
+            const uint16_t dstHeight{MipSize(image->Height, mip)};
+
+            auto& dst{image->Mips[mip]};
+            dst.resize(static_cast<size_t>(dstWidth) * dstHeight * BYTES_PER_PIXEL);
+            for (uint16_t y = 0; y < dstHeight; ++y)
+            {
+                const uint16_t y0{static_cast<uint16_t>(std::min(y * 2, srcHeight - 1))};
+                const uint16_t y1{static_cast<uint16_t>(std::min(y * 2 + 1, srcHeight - 1))};
+                for (uint16_t x = 0; x < dstWidth; ++x)
+                {
+                    const uint16_t x0{static_cast<uint16_t>(std::min(x * 2, srcWidth - 1))};
+                    const uint16_t x1{static_cast<uint16_t>(std::min(x * 2 + 1, srcWidth - 1))};
+                    for (uint32_t channel = 0; channel < BYTES_PER_PIXEL; ++channel)
+                    {
+                        const uint32_t sum{
+                            src[(static_cast<size_t>(y0) * srcWidth + x0) * BYTES_PER_PIXEL + channel] +
+                            src[(static_cast<size_t>(y0) * srcWidth + x1) * BYTES_PER_PIXEL + channel] +
+                            src[(static_cast<size_t>(y1) * srcWidth + x0) * BYTES_PER_PIXEL + channel] +
+                            src[(static_cast<size_t>(y1) * srcWidth + x1) * BYTES_PER_PIXEL + channel]};
+                        dst[(static_cast<size_t>(y) * dstWidth + x) * BYTES_PER_PIXEL + channel] = static_cast<uint8_t>((sum + 2) / 4);
+                    }
+                }
+            }
+        }
+
+        return image;
+    }
+
+    std::shared_ptr<Graphics::Texture> TextureAtlas::CreatePage() const
+    {
+        auto texture{std::make_shared<Graphics::Texture>(m_deviceContext)};
+        texture->Create2D(m_pageSize, m_pageSize, true, 1, bgfx::TextureFormat::RGBA8, BGFX_TEXTURE_NONE);
+
+        // Regions hand the page to JavaScript, where deleting it would pull it out from under the other regions.
+        texture->MarkShared();
+        return texture;
+    }
+
+    void TextureAtlas::Place(Entry& entry)
+    {
+        const uint16_t width{entry.Image->Width};
+        const uint16_t height{entry.Image->Height};
+
+        size_t index{0};
+        for (; index < m_pages.size(); ++index)
+        {
+            if (m_pages[index].Packer.Pack(width, height, entry.X, entry.Y))
+            {
+                break;
+            }
+        }
+
+        if (index == m_pages.size())
+        {
+            m_pages.push_back({CreatePage(), SkylinePacker{m_pageSize, m_pageSize}});
+            const bool placed{m_pages.back().Packer.Pack(width, height, entry.X, entry.Y)};
+            assert(placed);
+            (void)placed;
+        }
+
+        entry.Page = index;
+        m_pages[index].UsedArea += static_cast<size_t>(width) * height;
+        m_pages[index].EntryCount++;
+    }
+
+    void TextureAtlas::Upload(const Entry& entry) const
+    {
+        Graphics::Texture& texture{*m_pages[entry.Page].Texture};
+        for (uint8_t mip = 0; mip < m_numMips; ++mip)
+        {
+            const auto& data{entry.Image->Mips[mip]};
+            texture.Update2D(0, mip, static_cast<uint16_t>(entry.X >> mip), static_cast<uint16_t>(entry.Y >> mip),
+                MipSize(entry.Image->Width, mip), MipSize(entry.Image->Height, mip), bgfx::copy(data.data(), static_cast<uint32_t>(data.size())));
+        }
+    }
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <Babylon/Graphics/Texture.h>
+
+#include <gsl/gsl>
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace Babylon
+{
+    namespace Graphics
+    {
+        class DeviceContext;
+    }
+
+    // Bottom-left skyline rectangle packer.
+    class SkylinePacker final
+    {
+    public:
+        SkylinePacker(uint16_t width, uint16_t height);
+
+        bool Pack(uint16_t width, uint16_t height, uint16_t& x, uint16_t& y);
+        void Reset();
+
+    private:
+        struct Node
+        {
+            uint16_t X{};
+            uint16_t Y{};
+            uint16_t Width{};
+        };
+
+        bool Fits(size_t index, uint16_t width, uint16_t height, uint16_t& y) const;
+
+        uint16_t m_width{};
+        uint16_t m_height{};
+        std::vector<Node> m_skyline{};
+    };
+
+    // Packs small RGBA8 images into shared mipmapped pages. Each image is surrounded by a gutter of replicated edge pixels
+    // and placed on a grid aligned to the number of mips that are guaranteed not to bleed into neighboring images.
+    class TextureAtlas final
+    {
+    public:
+        // Mip levels that never sample neighboring images.
+        static constexpr uint8_t SAFE_MIP_LEVELS{4};
+        static constexpr uint16_t ALIGNMENT{1 << (SAFE_MIP_LEVELS - 1)};
+        static constexpr uint16_t GUTTER{ALIGNMENT};
+
+        struct Region
+        {
+            std::shared_ptr<Graphics::Texture> Page{};
+            float U0{};
+            float V0{};
+            float U1{};
+            float V1{};
+        };
+
+        TextureAtlas(Graphics::DeviceContext& deviceContext, uint16_t pageSize);
+
+        TextureAtlas(const TextureAtlas&) = delete;
+        TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+        uint32_t Add(gsl::span<const uint8_t> rgba, uint16_t width, uint16_t height);
+        void Remove(uint32_t id);
+        Region GetRegion(uint32_t id) const;
+
+        // Fraction of the allocated page area that is not used by live images.
+        float GetFragmentation() const;
+
+        // Compaction is split so the packing and page composition can run on a background thread.
+        struct CompactionPlan;
+        std::shared_ptr<CompactionPlan> BeginCompaction() const;
+        static void BuildCompaction(CompactionPlan& plan);
+        void EndCompaction(CompactionPlan& plan);
+
+    private:
+        // The padded image and its mip chain. Immutable once built so it can be shared with compaction.
+        struct PaddedImage
+        {
+            uint16_t Width{};
+            uint16_t Height{};
+            std::vector<std::vector<uint8_t>> Mips{};
+        };
+
+        struct Entry
+        {
+            std::shared_ptr<const PaddedImage> Image{};
+            uint16_t ImageWidth{};
+            uint16_t ImageHeight{};
+            size_t Page{};
+            uint16_t X{};
+            uint16_t Y{};
+        };
+
+        struct Page
+        {
+            std::shared_ptr<Graphics::Texture> Texture{};
+            SkylinePacker Packer;
+            size_t UsedArea{};
+            size_t EntryCount{};
+        };
+
+        static std::shared_ptr<const PaddedImage> BuildPaddedImage(gsl::span<const uint8_t> rgba, uint16_t width, uint16_t height, uint8_t numMips);
+        std::shared_ptr<Graphics::Texture> CreatePage() const;
+        void Place(Entry& entry);
+        void Upload(const Entry& entry) const;
+
+        Graphics::DeviceContext& m_deviceContext;
+        const uint16_t m_pageSize;
+        const uint8_t m_numMips;
+        std::vector<Page> m_pages{};
+        std::unordered_map<uint32_t, Entry> m_entries{};
+        uint32_t m_nextId{1};
+    };
+
+    struct TextureAtlas::CompactionPlan
+    {
+        struct Item
+        {
+            uint32_t Id{};
+            std::shared_ptr<const PaddedImage> Image{};
+            size_t Page{};
+            uint16_t X{};
+            uint16_t Y{};
+        };
+
+        uint16_t PageSize{};
+        uint8_t NumMips{};
+        std::vector<Item> Items{};
+        std::vector<SkylinePacker> Packers{};
+
+        // Composed pixels of each new page, per mip level.
+        std::vector<std::vector<std::vector<uint8_t>>> Pages{};
+    };
+}
@@ -479,6 +479,8 @@ namespace Babylon
             {
                 void* ColorTexturePointer{nullptr};
                 void* DepthTexturePointer{nullptr};
+                bgfx::TextureHandle ColorTexture{bgfx::kInvalidHandle};
+                bgfx::TextureHandle DepthTexture{bgfx::kInvalidHandle};
                 xr::Size ViewTextureSize{};
                 std::vector<Graphics::FrameBuffer*> FrameBuffers{};
                 std::map<Graphics::FrameBuffer*, Napi::ObjectReference> JsTextures{};
@@ -517,6 +519,7 @@ namespace Babylon
             void EndFrame();
 
             void NotifySessionStateChanged(bool isSessionActive);
+            void RemoveViewTextures(const ViewConfiguration& viewConfig);
         };
 
         NativeXr::Impl::Impl(Napi::Env env)
@@ -551,6 +554,19 @@ namespace Babylon
             }
         }
 
+        void NativeXr::Impl::RemoveViewTextures(const ViewConfiguration& viewConfig)
+        {
+            if (bgfx::isValid(viewConfig.ColorTexture))
+            {
+                m_sessionState->GraphicsContext.RemoveTexture(viewConfig.ColorTexture);
+            }
+
+            if (bgfx::isValid(viewConfig.DepthTexture))
+            {
+                m_sessionState->GraphicsContext.RemoveTexture(viewConfig.DepthTexture);
+            }
+        }
+
         arcana::task<void, std::exception_ptr> NativeXr::Impl::BeginSessionAsync()
         {
             if (m_beginTask)
@@ -560,6 +576,13 @@ namespace Babylon
 
             Graphics::DeviceContext& context = Graphics::DeviceContext::GetFromJavaScript(m_env);
 
+            // XR swapchain textures are bound with bgfx::overrideInternal, which must run on the render thread. With
+            // multithreaded rendering that thread belongs to bgfx, so XR sessions are not supported.
+            if (context.IsMultithreaded())
+            {
+                return arcana::task_from_error<void>(std::make_exception_ptr(std::runtime_error{"Immersive XR sessions are not supported with multithreaded rendering."}));
+            }
+
             // Don't try to start a session while it is still ending.
             m_beginTask.emplace(m_endTask.then(context.AfterRenderScheduler(), arcana::cancellation::none(),
                 [this, thisRef{shared_from_this()}, &context]() {
@@ -592,6 +615,10 @@ namespace Babylon
 
             m_sessionState->ActiveViewConfigurations.clear();
             m_sessionState->ViewConfigurationStartViewIdx.clear();
+            for (const auto& [texturePointer, viewConfig] : m_sessionState->TextureToViewConfigurationMap)
+            {
+                RemoveViewTextures(viewConfig);
+            }
             m_sessionState->TextureToViewConfigurationMap.clear();
             m_sessionState->ScheduleFrameCallbacks.clear();
             m_sessionState->CreateRenderTexture.Reset();
@@ -691,6 +718,7 @@ namespace Babylon
                             m_sessionState->DestroyRenderTexture.Call({jsTexture.Value()});
                         }
 
+                        RemoveViewTextures(viewConfig);
                         m_sessionState->TextureToViewConfigurationMap.erase(texturePointer);
                     }
                 }).then(m_sessionState->GraphicsContext.AfterRenderScheduler(), arcana::cancellation::none(), [] {}); // Ensure continuations run on the render thread if they use inline_scheduler.
@@ -716,6 +744,11 @@ namespace Babylon
                     it->second.ViewTextureSize.Height != view.ColorTextureSize.Height ||
                     it->second.ViewTextureSize.Depth != view.ColorTextureSize.Depth)
                 {
+                    if (it != m_sessionState->TextureToViewConfigurationMap.end())
+                    {
+                        RemoveViewTextures(it->second);
+                    }
+
                     auto& viewConfig = m_sessionState->TextureToViewConfigurationMap[view.ColorTexturePointer] = {};
                     m_sessionState->ActiveViewConfigurations[viewIdx] = &viewConfig;
                     m_sessionState->ViewConfigurationStartViewIdx[&viewConfig] = viewIdx;
@@ -747,6 +780,9 @@ namespace Babylon
                     auto depthTexture = bgfx::createTexture2D(textureWidth, textureHeight, false, textureLayers, depthTextureFormat, BGFX_TEXTURE_RT);
                     m_sessionState->GraphicsContext.AddTexture(depthTexture, textureWidth, textureHeight, false, textureLayers, depthTextureFormat);
 
+                    viewConfig.ColorTexture = colorTexture;
+                    viewConfig.DepthTexture = depthTexture;
+
                     auto requiresAppClear = view.RequiresAppClear;
 
                     arcana::make_task(m_sessionState->GraphicsContext.AfterRenderScheduler(), arcana::cancellation::none(), [colorTexture, depthTexture, &viewConfig]() {
@@ -1,6 +1,7 @@
 #include "Canvas.h"
 #include "Image.h"
 #include "Context.h"
+#include "ImageData.h"
 #include <bgfx/bgfx.h>
 #include <napi/napi_pointer.h>
 #include <cassert>
@@ -59,15 +60,15 @@ namespace Babylon::Polyfills::Internal
     Napi::Value NativeCanvas::LoadTTFAsync(const Napi::CallbackInfo& info)
     {
         const auto buffer = info[1].As<Napi::ArrayBuffer>();
-        std::vector<uint8_t> fontBuffer(buffer.ByteLength());
-        memcpy(fontBuffer.data(), (uint8_t*)buffer.Data(), buffer.ByteLength());
+        auto fontData{std::make_shared<const std::vector<uint8_t>>(static_cast<uint8_t*>(buffer.Data()), static_cast<uint8_t*>(buffer.Data()) + buffer.ByteLength())};
+        auto impl{Polyfills::Canvas::Impl::GetFromJavaScript(info.Env()).shared_from_this()};
 
         auto& graphicsContext{Graphics::DeviceContext::GetFromJavaScript(info.Env())};
         auto update = graphicsContext.GetUpdate("update");
         std::shared_ptr<JsRuntimeScheduler> runtimeScheduler{std::make_shared<JsRuntimeScheduler>(JsRuntime::GetFromJavaScript(info.Env()))};
         auto deferred{Napi::Promise::Deferred::New(info.Env())};
-        arcana::make_task(update.Scheduler(), arcana::cancellation::none(), [fontName{info[0].As<Napi::String>().Utf8Value()}, fontData{std::move(fontBuffer)}]() {
-            fontsInfos[fontName] = fontData;
+        arcana::make_task(update.Scheduler(), arcana::cancellation::none(), [impl{std::move(impl)}, fontName{info[0].As<Napi::String>().Utf8Value()}, fontData{std::move(fontData)}]() {
+            impl->AddFont(fontName, fontData);
         }).then(*runtimeScheduler, arcana::cancellation::none(), [runtimeScheduler /*Keep reference alive*/, env{info.Env()}, deferred]() {
             deferred.Resolve(env.Undefined());
         });
@@ -212,6 +213,18 @@ namespace Babylon::Polyfills
         }
     }
 
+    void Canvas::Impl::AddFont(const std::string& name, FontData data)
+    {
+        std::scoped_lock lock{m_fontsMutex};
+        m_fonts[name] = std::move(data);
+    }
+
+    std::map<std::string, Canvas::Impl::FontData> Canvas::Impl::GetFonts() const
+    {
+        std::scoped_lock lock{m_fontsMutex};
+        return m_fonts;
+    }
+
     void Canvas::Impl::FlushGraphicResources()
     {
         for (auto monitoredResource : m_monitoredResources)
@@ -237,6 +250,8 @@ namespace Babylon::Polyfills
         Internal::NativeCanvasImage::CreateInstance(env);
 
         Internal::Context::Initialize(env);
+        Internal::CanvasGradient::Initialize(env);
+        Internal::ImageData::Initialize(env);
 
         return {impl};
     }
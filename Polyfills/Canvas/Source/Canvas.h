@@ -6,6 +6,9 @@
 #include <Babylon/Graphics/FrameBuffer.h>
 #include <Babylon/Graphics/Texture.h>
 
+#include <map>
+#include <mutex>
+
 namespace Babylon::Polyfills
 {
     class Canvas::Impl final : public std::enable_shared_from_this<Canvas::Impl>
@@ -17,6 +20,11 @@ namespace Babylon::Polyfills
 
         static Canvas::Impl& GetFromJavaScript(Napi::Env env);
 
+        // Font files are shared with the contexts that use them, which keep them alive.
+        using FontData = std::shared_ptr<const std::vector<uint8_t>>;
+        void AddFont(const std::string& name, FontData data);
+        std::map<std::string, FontData> GetFonts() const;
+
         struct MonitoredResource
         {
             MonitoredResource(Canvas::Impl& impl)
@@ -42,6 +50,10 @@ namespace Babylon::Polyfills
 
         std::vector<MonitoredResource*> m_monitoredResources{};
 
+        // Fonts are registered on the render thread and read on the JavaScript thread.
+        mutable std::mutex m_fontsMutex{};
+        std::map<std::string, FontData> m_fonts{};
+
         void AddMonitoredResource(MonitoredResource* monitoredResource);
         void RemoveMonitoredResource(MonitoredResource* monitoredResource);
 
@@ -62,8 +74,6 @@ namespace Babylon::Polyfills::Internal
         uint32_t GetWidth() const { return m_width; }
         uint32_t GetHeight() const { return m_height; }
 
-        static inline std::map<std::string, std::vector<uint8_t>> fontsInfos;
-
         // returns true if frameBuffer size has changed
         bool UpdateRenderTarget();
         Babylon::Graphics::FrameBuffer& GetFrameBuffer() { return *m_frameBuffer; }
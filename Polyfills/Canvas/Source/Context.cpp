@@ -2,7 +2,9 @@
 #include <map>
 #include <algorithm>
 #include <cassert>
-#include <regex>
+#include <cmath>
+#include <cstring>
+#include <limits>
 
 #ifdef __GNUC__
 #pragma GCC diagnostic push
@@ -23,8 +25,10 @@
 #include "Canvas.h"
 #include "Context.h"
 #include "MeasureText.h"
+#include "FontShorthand.h"
 #include "Image.h"
 #include "ImageData.h"
+#include "Gradient.h"
 #include "Colors.h"
 
 /*
@@ -34,6 +38,99 @@ namespace Babylon::Polyfills::Internal
 {
     static constexpr auto JS_CONTEXT_CONSTRUCTOR_NAME = "Context";
 
+    // Enough for the labels of a busy UI to be measured once.
+    static constexpr size_t TEXT_CACHE_CAPACITY = 1024;
+
+    // UI code sets a handful of distinct font strings, so the memo is simply dropped if it ever grows this large.
+    static constexpr size_t FONT_MEMO_CAPACITY = 256;
+
+    namespace
+    {
+        // The scale nanovg applies to stroke widths under a transform.
+        float GetAverageScale(const float* transform)
+        {
+            const float scaleX{std::sqrt(transform[0] * transform[0] + transform[2] * transform[2])};
+            const float scaleY{std::sqrt(transform[1] * transform[1] + transform[3] * transform[3])};
+            return (scaleX + scaleY) * 0.5f;
+        }
+
+        // Decodes the next code point of UTF-8 text, replacing invalid sequences with U+FFFD.
+        uint32_t NextCodepoint(const std::string& text, size_t& index)
+        {
+            const auto lead{static_cast<uint8_t>(text[index++])};
+            const size_t length{lead < 0x80 ? 0u : (lead >> 5) == 0x6 ? 1u : (lead >> 4) == 0xE ? 2u : (lead >> 3) == 0x1E ? 3u : 4u};
+            if (length == 0)
+            {
+                return lead;
+            }
+            if (length == 4 || index + length > text.size())
+            {
+                return 0xFFFD;
+            }
+
+            uint32_t codepoint{lead & (0x3Fu >> length)};
+            for (size_t byte = 0; byte < length; ++byte)
+            {
+                const auto continuation{static_cast<uint8_t>(text[index])};
+                if ((continuation >> 6) != 0x2)
+                {
+                    return 0xFFFD;
+                }
+                codepoint = (codepoint << 6) | (continuation & 0x3F);
+                ++index;
+            }
+            return codepoint;
+        }
+
+        // Copies a rectangle of RGBA pixels between images, skipping the parts that fall outside of either image.
+        void CopyPixels(const uint8_t* source, uint32_t sourceWidth, uint32_t sourceHeight, int64_t sourceX, int64_t sourceY,
+            uint8_t* destination, uint32_t destinationWidth, uint32_t destinationHeight, int64_t destinationX, int64_t destinationY,
+            int64_t width, int64_t height)
+        {
+            const int64_t skipLeft{std::max({int64_t{0}, -sourceX, -destinationX})};
+            const int64_t skipTop{std::max({int64_t{0}, -sourceY, -destinationY})};
+            width = std::min({width, int64_t{sourceWidth} - sourceX, int64_t{destinationWidth} - destinationX}) - skipLeft;
+            height = std::min({height, int64_t{sourceHeight} - sourceY, int64_t{destinationHeight} - destinationY}) - skipTop;
+            if (width <= 0 || height <= 0)
+            {
+                return;
+            }
+
+            for (int64_t row = skipTop; row < skipTop + height; ++row)
+            {
+                std::memcpy(destination + ((destinationY + row) * destinationWidth + destinationX + skipLeft) * 4,
+                    source + ((sourceY + row) * sourceWidth + sourceX + skipLeft) * 4,
+                    static_cast<size_t>(width) * 4);
+            }
+        }
+
+        // The canvas stores premultiplied colors, image data doesn't.
+        void Unpremultiply(const uint8_t* source, uint8_t* destination)
+        {
+            const uint32_t alpha{source[3]};
+            for (int channel = 0; channel < 3; ++channel)
+            {
+                destination[channel] = alpha == 0 ? 0 : static_cast<uint8_t>(std::min((source[channel] * 255u + alpha / 2) / alpha, 255u));
+            }
+            destination[3] = source[3];
+        }
+
+        // Normalizes a rectangle given with a negative width or height, as getImageData and putImageData allow.
+        void NormalizeRect(int64_t& x, int64_t& y, int64_t& width, int64_t& height)
+        {
+            if (width < 0)
+            {
+                x += width;
+                width = -width;
+            }
+            if (height < 0)
+            {
+                y += height;
+                height = -height;
+            }
+        }
+    }
+
     void Context::Initialize(Napi::Env env)
     {
         Napi::HandleScope scope{env};
@@ -64,14 +161,21 @@ namespace Babylon::Polyfills::Internal
                 InstanceMethod("fill", &Context::Fill),
                 InstanceMethod("drawImage", &Context::DrawImage),
                 InstanceMethod("getImageData", &Context::GetImageData),
+                InstanceMethod("getImageDataAsync", &Context::GetImageDataAsync),
+                InstanceMethod("createImageData", &Context::CreateImageData),
                 InstanceMethod("setLineDash", &Context::SetLineDash),
+                InstanceMethod("getLineDash", &Context::GetLineDash),
                 InstanceMethod("fillText", &Context::FillText),
                 InstanceMethod("strokeText", &Context::StrokeText),
                 InstanceMethod("createLinearGradient", &Context::CreateLinearGradient),
+                InstanceMethod("createRadialGradient", &Context::CreateRadialGradient),
                 InstanceMethod("setTransform", &Context::SetTransform),
+                InstanceMethod("transform", &Context::Transform),
+                InstanceMethod("resetTransform", &Context::ResetTransform),
                 InstanceMethod("dispose", &Context::Dispose),
                 InstanceAccessor("lineJoin", &Context::GetLineJoin, &Context::SetLineJoin),
                 InstanceAccessor("miterLimit", &Context::GetMiterLimit, &Context::SetMiterLimit),
+                InstanceAccessor("lineDashOffset", &Context::GetLineDashOffset, &Context::SetLineDashOffset),
                 InstanceAccessor("font", &Context::GetFont, &Context::SetFont),
                 InstanceAccessor("strokeStyle", &Context::GetStrokeStyle, &Context::SetStrokeStyle),
                 InstanceAccessor("fillStyle", &Context::GetFillStyle, &Context::SetFillStyle),
@@ -82,6 +186,7 @@ namespace Babylon::Polyfills::Internal
                 InstanceAccessor("shadowOffsetY", &Context::GetShadowOffsetY, &Context::SetShadowOffsetY),
                 InstanceAccessor("lineWidth", &Context::GetLineWidth, &Context::SetLineWidth),
                 InstanceAccessor("canvas", &Context::GetCanvas, nullptr),
+                InstanceAccessor("imageDataReady", &Context::GetImageDataReady, nullptr),
             });
         JsRuntime::NativeObject::GetFromJavaScript(env).Set(JS_CONTEXT_CONSTRUCTOR_NAME, func);
     }
@@ -102,11 +207,14 @@ namespace Babylon::Polyfills::Internal
         , m_update{m_graphicsContext.GetUpdate("update")}
         , m_cancellationSource{std::make_shared<arcana::cancellation_source>()}
         , m_runtimeScheduler{Babylon::JsRuntime::GetFromJavaScript(info.Env())}
+        , m_textCache{TEXT_CACHE_CAPACITY}
         , Polyfills::Canvas::Impl::MonitoredResource{Polyfills::Canvas::Impl::GetFromJavaScript(info.Env())}
     {
-        for (auto& font : NativeCanvas::fontsInfos)
+        m_fontData = Polyfills::Canvas::Impl::GetFromJavaScript(info.Env()).GetFonts();
+        for (auto& [name, data] : m_fontData)
         {
-            m_fonts[font.first] = nvgCreateFontMem(m_nvg, font.first.c_str(), font.second.data(), static_cast<int>(font.second.size()), 0);
+            // nanovg doesn't modify font data it doesn't own.
+            m_fonts[name] = nvgCreateFontMem(m_nvg, name.c_str(), const_cast<uint8_t*>(data->data()), static_cast<int>(data->size()), 0);
         }
     }
 
@@ -130,10 +238,30 @@ namespace Babylon::Polyfills::Internal
     {
         if (m_nvg)
         {
-            for (auto& image : m_nvgImageIndices)
+            for (auto& image : m_canvasImages)
             {
-                nvgDeleteImage(m_nvg, image.second);
+                nvgDeleteImage(m_nvg, image.second.NvgImage);
+            }
+            m_canvasImages.clear();
+            for (auto& image : m_retiredCanvasImages)
+            {
+                nvgDeleteImage(m_nvg, image.NvgImage);
+            }
+            m_retiredCanvasImages.clear();
+            m_gradientImages.Clear(m_nvg);
+            for (auto& putImage : m_putImages)
+            {
+                nvgDeleteImage(m_nvg, putImage.Image);
+            }
+            m_putImages.clear();
+            for (auto& texture : m_readbackTextures)
+            {
+                if (texture.DeviceId == m_graphicsContext.GetDeviceId())
+                {
+                    bgfx::destroy(texture.Handle);
+                }
             }
+            m_readbackTextures.clear();
             nvgDelete(m_nvg);
             m_nvg = nullptr;
         }
@@ -150,40 +278,84 @@ namespace Babylon::Polyfills::Internal
 
         if (!m_isClipped)
         {
-            nvgBeginPath(m_nvg);
+            PathBegin();
         }
 
-        nvgRect(m_nvg, left, top, width, height);
+        PathRect(left, top, width, height);
 
-        const auto color = StringToColor(info.Env(), m_fillStyle);
-        nvgFillColor(m_nvg, color);
+        ApplyFillStyle();
         nvgFill(m_nvg);
-        SetDirty();
+        AddDamage(m_pathBounds);
+    }
+
+    Context::PaintStyle Context::ToPaintStyle(const Napi::Value& value) const
+    {
+        PaintStyle style{};
+        if (CanvasGradient::TryUnwrap(value) != nullptr)
+        {
+            style.Color.clear();
+            style.Gradient = std::make_shared<Napi::ObjectReference>(Napi::Persistent(value.As<Napi::Object>()));
+            return style;
+        }
+
+        style.Color = value.As<Napi::String>().Utf8Value();
+        style.ParsedColor = StringToColor(Env(), style.Color);
+        return style;
+    }
+
+    Napi::Value Context::FromPaintStyle(const PaintStyle& style) const
+    {
+        if (style.Gradient)
+        {
+            return style.Gradient->Value();
+        }
+
+        return Napi::Value::From(Env(), style.Color);
+    }
+
+    void Context::ApplyFillStyle()
+    {
+        if (m_fillStyle.Gradient)
+        {
+            nvgFillPaint(m_nvg, CanvasGradient::Unwrap(m_fillStyle.Gradient->Value())->CreatePaint(m_nvg, m_gradientImages));
+        }
+        else
+        {
+            nvgFillColor(m_nvg, m_fillStyle.ParsedColor);
+        }
+    }
+
+    void Context::ApplyStrokeStyle()
+    {
+        if (m_strokeStyle.Gradient)
+        {
+            nvgStrokePaint(m_nvg, CanvasGradient::Unwrap(m_strokeStyle.Gradient->Value())->CreatePaint(m_nvg, m_gradientImages));
+        }
+        else
+        {
+            nvgStrokeColor(m_nvg, m_strokeStyle.ParsedColor);
+        }
     }
 
     Napi::Value Context::GetFillStyle(const Napi::CallbackInfo&)
     {
-        return Napi::Value::From(Env(), m_fillStyle);
+        return FromPaintStyle(m_fillStyle);
     }
 
-    void Context::SetFillStyle(const Napi::CallbackInfo& info, const Napi::Value& value)
+    void Context::SetFillStyle(const Napi::CallbackInfo&, const Napi::Value& value)
     {
-        m_fillStyle = value.As<Napi::String>().Utf8Value();
-        const auto color = StringToColor(info.Env(), m_fillStyle);
-        nvgFillColor(m_nvg, color);
+        m_fillStyle = ToPaintStyle(value);
         SetDirty();
     }
 
     Napi::Value Context::GetStrokeStyle(const Napi::CallbackInfo&)
     {
-        return Napi::Value::From(Env(), m_strokeStyle);
+        return FromPaintStyle(m_strokeStyle);
     }
 
-    void Context::SetStrokeStyle(const Napi::CallbackInfo& info, const Napi::Value& value)
+    void Context::SetStrokeStyle(const Napi::CallbackInfo&, const Napi::Value& value)
     {
-        m_strokeStyle = value.As<Napi::String>().Utf8Value();
-        auto color = StringToColor(info.Env(), m_strokeStyle);
-        nvgStrokeColor(m_nvg, color);
+        m_strokeStyle = ToPaintStyle(value);
         SetDirty();
     }
 
@@ -201,19 +373,36 @@ namespace Babylon::Polyfills::Internal
 
     void Context::Fill(const Napi::CallbackInfo&)
     {
+        ApplyFillStyle();
         nvgFill(m_nvg);
-        SetDirty();
+        AddDamage(m_pathBounds);
     }
 
     void Context::Save(const Napi::CallbackInfo&)
     {
         nvgSave(m_nvg);
+        m_savedStates.push_back({m_font, m_currentFontId, m_fontSize, m_fillStyle, m_strokeStyle, m_lineWidth, m_lineJoin, m_miterLimit, m_lineDash, m_lineDashOffset});
         SetDirty();
     }
 
     void Context::Restore(const Napi::CallbackInfo&)
     {
         nvgRestore(m_nvg);
+        if (!m_savedStates.empty())
+        {
+            auto& state{m_savedStates.back()};
+            m_font = std::move(state.Font);
+            m_currentFontId = state.FontId;
+            m_fontSize = state.FontSize;
+            m_fillStyle = std::move(state.FillStyle);
+            m_strokeStyle = std::move(state.StrokeStyle);
+            m_lineWidth = state.LineWidth;
+            m_lineJoin = state.LineJoin;
+            m_miterLimit = state.MiterLimit;
+            m_lineDash = std::move(state.LineDash);
+            m_lineDashOffset = state.LineDashOffset;
+            m_savedStates.pop_back();
+        }
         SetDirty();
         m_isClipped = false;
     }
@@ -230,20 +419,20 @@ namespace Babylon::Polyfills::Internal
 
         if (!m_isClipped)
         {
-            nvgBeginPath(m_nvg);
+            PathBegin();
         }
 
-        nvgRect(m_nvg, x, y, width, height);
+        PathRect(x, y, width, height);
 
         if (!m_isClipped)
         {
-            nvgClosePath(m_nvg);
+            PathClose();
         }
 
         nvgFillColor(m_nvg, TRANSPARENT_BLACK);
         nvgFill(m_nvg);
         nvgRestore(m_nvg);
-        SetDirty();
+        AddDamage(m_pathBounds);
     }
 
     void Context::Translate(const Napi::CallbackInfo& info)
@@ -257,7 +446,7 @@ namespace Babylon::Polyfills::Internal
     void Context::Rotate(const Napi::CallbackInfo& info)
     {
         const auto angle = info[0].As<Napi::Number>().FloatValue();
-        nvgRotate(m_nvg, nvgDegToRad(angle));
+        nvgRotate(m_nvg, angle);
         SetDirty();
     }
 
@@ -271,13 +460,13 @@ namespace Babylon::Polyfills::Internal
 
     void Context::BeginPath(const Napi::CallbackInfo&)
     {
-        nvgBeginPath(m_nvg);
+        PathBegin();
         SetDirty();
     }
 
     void Context::ClosePath(const Napi::CallbackInfo&)
     {
-        nvgClosePath(m_nvg);
+        PathClose();
         SetDirty();
     }
 
@@ -288,7 +477,7 @@ namespace Babylon::Polyfills::Internal
         const auto width = info[2].As<Napi::Number>().FloatValue();
         const auto height = info[3].As<Napi::Number>().FloatValue();
 
-        nvgRect(m_nvg, left, top, width, height);
+        PathRect(left, top, width, height);
         m_rectangleClipping = {left, top, width, height};
         SetDirty();
     }
@@ -303,6 +492,12 @@ namespace Babylon::Polyfills::Internal
 
         // expand clipping 1pix in each direction because nanovg AA gets cut a bit short.
         nvgScissor(m_nvg, m_rectangleClipping.left - 1, m_rectangleClipping.top - 1, w + 1, h + 1);
+
+        const Bounds pathBounds{m_pathBounds};
+        m_pathBounds = {};
+        AddRectToPath(m_rectangleClipping.left - 1, m_rectangleClipping.top - 1, w + 1, h + 1);
+        m_clipBounds = m_pathBounds;
+        m_pathBounds = pathBounds;
     }
 
     void Context::StrokeRect(const Napi::CallbackInfo& info)
@@ -312,15 +507,37 @@ namespace Babylon::Polyfills::Internal
         const auto width = info[2].As<Napi::Number>().FloatValue();
         const auto height = info[3].As<Napi::Number>().FloatValue();
 
-        nvgRect(m_nvg, left, top, width, height);
-        nvgStroke(m_nvg);
-        SetDirty();
+        PathRect(left, top, width, height);
+        if (m_lineDash.empty())
+        {
+            ApplyStrokeStyle();
+            nvgStroke(m_nvg);
+        }
+        else
+        {
+            StrokeCanvasPath(m_path);
+        }
+
+        Bounds bounds{m_pathBounds};
+        bounds.Expand(GetStrokeExtent());
+        AddDamage(bounds);
     }
 
     void Context::Stroke(const Napi::CallbackInfo&)
     {
-        nvgStroke(m_nvg);
-        SetDirty();
+        if (m_lineDash.empty())
+        {
+            ApplyStrokeStyle();
+            nvgStroke(m_nvg);
+        }
+        else
+        {
+            StrokeCanvasPath(m_path);
+        }
+
+        Bounds bounds{m_pathBounds};
+        bounds.Expand(GetStrokeExtent());
+        AddDamage(bounds);
     }
 
     void Context::MoveTo(const Napi::CallbackInfo& info)
@@ -328,7 +545,7 @@ namespace Babylon::Polyfills::Internal
         const auto x = info[0].As<Napi::Number>().FloatValue();
         const auto y = info[1].As<Napi::Number>().FloatValue();
 
-        nvgMoveTo(m_nvg, x, y);
+        PathMoveTo(x, y);
         SetDirty();
     }
 
@@ -337,7 +554,7 @@ namespace Babylon::Polyfills::Internal
         const auto x = info[0].As<Napi::Number>().FloatValue();
         const auto y = info[1].As<Napi::Number>().FloatValue();
 
-        nvgLineTo(m_nvg, x, y);
+        PathLineTo(x, y);
         SetDirty();
     }
 
@@ -348,14 +565,45 @@ namespace Babylon::Polyfills::Internal
         const auto x = info[2].As<Napi::Number>().FloatValue();
         const auto y = info[3].As<Napi::Number>().FloatValue();
 
-        nvgBezierTo(m_nvg, cx, cy, cx, cy, x, y);
+        PathBezierTo(cx, cy, cx, cy, x, y);
         SetDirty();
     }
 
+    int Context::SelectFont()
+    {
+        if (m_fonts.empty())
+        {
+            return -1;
+        }
+
+        const int fontId{m_currentFontId >= 0 ? m_currentFontId : m_fonts.begin()->second};
+        nvgFontFaceId(m_nvg, fontId);
+        return fontId;
+    }
+
+    const TextCache::Layout& Context::GetTextLayout(int fontId, const std::string& text)
+    {
+        if (const auto* layout{m_textCache.Find(fontId, m_fontSize, text)})
+        {
+            return *layout;
+        }
+
+        TextCache::Layout layout{};
+        layout.Advance = nvgTextBounds(m_nvg, 0, 0, text.c_str(), nullptr, layout.Bounds);
+        return m_textCache.Insert(fontId, m_fontSize, text, layout);
+    }
+
     Napi::Value Context::MeasureText(const Napi::CallbackInfo& info)
     {
         std::string text{info[0].As<Napi::String>()};
-        return MeasureText::CreateInstance(info.Env(), this, text);
+
+        const int fontId{SelectFont()};
+        if (fontId < 0)
+        {
+            return MeasureText::CreateInstance(info.Env(), TextCache::Layout{});
+        }
+
+        return MeasureText::CreateInstance(info.Env(), GetTextLayout(fontId, text));
     }
 
     void Context::FillText(const Napi::CallbackInfo& info)
@@ -364,20 +612,385 @@ namespace Babylon::Polyfills::Internal
         auto x = info[1].As<Napi::Number>().FloatValue();
         auto y = info[2].As<Napi::Number>().FloatValue();
 
-        if (!m_fonts.empty())
+        const int fontId{SelectFont()};
+        if (fontId < 0)
+        {
+            return;
+        }
+
+        // Text that falls entirely outside of the canvas is skipped without being laid out.
+        const Bounds bounds{GetTextBounds(GetTextLayout(fontId, text), x, y)};
+        if (bounds.MaxX < 0.f || bounds.MaxY < 0.f || bounds.MinX > static_cast<float>(m_canvas->GetWidth()) || bounds.MinY > static_cast<float>(m_canvas->GetHeight()))
+        {
+            return;
+        }
+
+        ApplyFillStyle();
+        nvgText(m_nvg, x, y, text.c_str(), nullptr);
+        AddDamage(bounds);
+    }
+
+    void Context::StrokeText(const Napi::CallbackInfo& info)
+    {
+        const std::string text = info[0].As<Napi::String>().Utf8Value();
+        const auto x = info[1].As<Napi::Number>().FloatValue();
+        const auto y = info[2].As<Napi::Number>().FloatValue();
+
+        const int fontId{SelectFont()};
+        const stbtt_fontinfo* font{fontId >= 0 ? GetOutlineFont(fontId) : nullptr};
+        if (font == nullptr)
+        {
+            return;
+        }
+
+        Bounds bounds{GetTextBounds(GetTextLayout(fontId, text), x, y)};
+        bounds.Expand(GetStrokeExtent());
+        if (bounds.MaxX < 0.f || bounds.MaxY < 0.f || bounds.MinX > static_cast<float>(m_canvas->GetWidth()) || bounds.MinY > static_cast<float>(m_canvas->GetHeight()))
+        {
+            return;
+        }
+
+        // Glyph outlines are in font units with y up, scaled to the font size as nanovg scales the glyphs it fills.
+        float transform[6];
+        nvgCurrentTransform(m_nvg, transform);
+        const float scale{stbtt_ScaleForPixelHeight(font, m_fontSize)};
+        CanvasPath outline{};
+        float penX{x};
+        int previousGlyph{0};
+        for (size_t index = 0; index < text.size();)
         {
-            if (m_currentFontId >= 0)
+            const int glyph{stbtt_FindGlyphIndex(font, static_cast<int>(NextCodepoint(text, index)))};
+            if (previousGlyph != 0)
             {
-                nvgFontFaceId(m_nvg, m_currentFontId);
+                penX += stbtt_GetGlyphKernAdvance(font, previousGlyph, glyph) * scale;
+            }
+
+            stbtt_vertex* vertices{};
+            const int vertexCount{stbtt_GetGlyphShape(font, glyph, &vertices)};
+            float lastX{}, lastY{};
+            for (int vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+            {
+                const auto& vertex{vertices[vertexIndex]};
+                const float vertexX{penX + vertex.x * scale};
+                const float vertexY{y - vertex.y * scale};
+                switch (vertex.type)
+                {
+                    case STBTT_vmove:
+                        if (vertexIndex > 0)
+                        {
+                            outline.Close();
+                        }
+                        outline.MoveTo(transform, vertexX, vertexY);
+                        break;
+                    case STBTT_vline:
+                        outline.LineTo(transform, vertexX, vertexY);
+                        break;
+                    case STBTT_vcurve:
+                    {
+                        // Quadratic curves are raised to cubic ones, which is all nanovg takes.
+                        const float controlX{penX + vertex.cx * scale};
+                        const float controlY{y - vertex.cy * scale};
+                        outline.BezierTo(transform, lastX + (controlX - lastX) * 2.f / 3.f, lastY + (controlY - lastY) * 2.f / 3.f,
+                            vertexX + (controlX - vertexX) * 2.f / 3.f, vertexY + (controlY - vertexY) * 2.f / 3.f, vertexX, vertexY);
+                        break;
+                    }
+                    case STBTT_vcubic:
+                        outline.BezierTo(transform, penX + vertex.cx * scale, y - vertex.cy * scale, penX + vertex.cx1 * scale, y - vertex.cy1 * scale, vertexX, vertexY);
+                        break;
+                }
+                lastX = vertexX;
+                lastY = vertexY;
+            }
+            if (vertexCount > 0)
+            {
+                outline.Close();
+            }
+            stbtt_FreeShape(font, vertices);
+
+            int advance{}, leftSideBearing{};
+            stbtt_GetGlyphHMetrics(font, glyph, &advance, &leftSideBearing);
+            penX += advance * scale;
+            previousGlyph = glyph;
+        }
+
+        StrokeCanvasPath(outline);
+        AddDamage(bounds);
+    }
+
+    const stbtt_fontinfo* Context::GetOutlineFont(int fontId)
+    {
+        auto it{m_outlineFonts.find(fontId)};
+        if (it == m_outlineFonts.end())
+        {
+            std::unique_ptr<stbtt_fontinfo> font{};
+            for (const auto& [name, id] : m_fonts)
+            {
+                const auto dataIt{m_fontData.find(name)};
+                if (id == fontId && dataIt != m_fontData.end())
+                {
+                    const uint8_t* data{dataIt->second->data()};
+                    font = std::make_unique<stbtt_fontinfo>();
+                    if (!stbtt_InitFont(font.get(), data, stbtt_GetFontOffsetForIndex(data, 0)))
+                    {
+                        font.reset();
+                    }
+                    break;
+                }
+            }
+
+            it = m_outlineFonts.emplace(fontId, std::move(font)).first;
+        }
+
+        return it->second.get();
+    }
+
+    Context::Bounds Context::GetTextBounds(const TextCache::Layout& layout, float x, float y)
+    {
+        float transform[6];
+        nvgCurrentTransform(m_nvg, transform);
+
+        Bounds bounds{};
+        for (int corner = 0; corner < 4; ++corner)
+        {
+            float cornerX{}, cornerY{};
+            nvgTransformPoint(&cornerX, &cornerY, transform, x + layout.Bounds[(corner & 1) * 2], y + layout.Bounds[1 + (corner >> 1) * 2]);
+            bounds.Add(cornerX, cornerY);
+        }
+        return bounds;
+    }
+
+    void Context::Bounds::Add(float x, float y)
+    {
+        MinX = std::min(MinX, x);
+        MinY = std::min(MinY, y);
+        MaxX = std::max(MaxX, x);
+        MaxY = std::max(MaxY, y);
+    }
+
+    void Context::Bounds::Add(const Bounds& other)
+    {
+        MinX = std::min(MinX, other.MinX);
+        MinY = std::min(MinY, other.MinY);
+        MaxX = std::max(MaxX, other.MaxX);
+        MaxY = std::max(MaxY, other.MaxY);
+    }
+
+    void Context::Bounds::Intersect(const Bounds& other)
+    {
+        MinX = std::max(MinX, other.MinX);
+        MinY = std::max(MinY, other.MinY);
+        MaxX = std::min(MaxX, other.MaxX);
+        MaxY = std::min(MaxY, other.MaxY);
+    }
+
+    void Context::Bounds::Expand(float amount)
+    {
+        MinX -= amount;
+        MinY -= amount;
+        MaxX += amount;
+        MaxY += amount;
+    }
+
+    void Context::AddToPath(float x, float y)
+    {
+        float transform[6];
+        nvgCurrentTransform(m_nvg, transform);
+
+        float canvasX{}, canvasY{};
+        nvgTransformPoint(&canvasX, &canvasY, transform, x, y);
+        m_pathBounds.Add(canvasX, canvasY);
+    }
+
+    void Context::AddRectToPath(float x, float y, float width, float height)
+    {
+        AddToPath(x, y);
+        AddToPath(x + width, y);
+        AddToPath(x, y + height);
+        AddToPath(x + width, y + height);
+    }
+
+    void Context::PathBegin()
+    {
+        nvgBeginPath(m_nvg);
+        m_path.Clear();
+        m_pathBounds = {};
+    }
+
+    void Context::PathMoveTo(float x, float y)
+    {
+        float transform[6];
+        nvgCurrentTransform(m_nvg, transform);
+        nvgMoveTo(m_nvg, x, y);
+        m_path.MoveTo(transform, x, y);
+        AddToPath(x, y);
+    }
+
+    void Context::PathLineTo(float x, float y)
+    {
+        float transform[6];
+        nvgCurrentTransform(m_nvg, transform);
+        nvgLineTo(m_nvg, x, y);
+        m_path.LineTo(transform, x, y);
+        AddToPath(x, y);
+    }
+
+    void Context::PathBezierTo(float c1x, float c1y, float c2x, float c2y, float x, float y)
+    {
+        float transform[6];
+        nvgCurrentTransform(m_nvg, transform);
+        nvgBezierTo(m_nvg, c1x, c1y, c2x, c2y, x, y);
+        m_path.BezierTo(transform, c1x, c1y, c2x, c2y, x, y);
+
+        // The curve lies within its control points.
+        AddToPath(c1x, c1y);
+        AddToPath(c2x, c2y);
+        AddToPath(x, y);
+    }
+
+    void Context::PathClose()
+    {
+        nvgClosePath(m_nvg);
+        m_path.Close();
+    }
+
+    void Context::PathRect(float x, float y, float width, float height)
+    {
+        // The same commands as nvgRect.
+        PathMoveTo(x, y);
+        PathLineTo(x, y + height);
+        PathLineTo(x + width, y + height);
+        PathLineTo(x + width, y);
+        PathClose();
+    }
+
+    void Context::PathArc(float x, float y, float radius, float startAngle, float endAngle, NVGwinding direction)
+    {
+        // The curves nvgArc makes, at most one per quarter turn, built here so that they are recorded too.
+        constexpr float PI{3.14159265358979323846f};
+        float sweep{endAngle - startAngle};
+        if (direction == NVG_CW)
+        {
+            if (std::abs(sweep) >= PI * 2.f)
+            {
+                sweep = PI * 2.f;
             }
             else
             {
-                nvgFontFaceId(m_nvg, m_fonts.begin()->second);
+                while (sweep < 0.f)
+                {
+                    sweep += PI * 2.f;
+                }
+            }
+        }
+        else
+        {
+            if (std::abs(sweep) >= PI * 2.f)
+            {
+                sweep = -PI * 2.f;
             }
+            else
+            {
+                while (sweep > 0.f)
+                {
+                    sweep -= PI * 2.f;
+                }
+            }
+        }
+
+        const int divisions{std::max(1, std::min(static_cast<int>(std::abs(sweep) / (PI * 0.5f) + 0.5f), 5))};
+        const float halfDivision{sweep / static_cast<float>(divisions) * 0.5f};
+        float kappa{std::abs(4.f / 3.f * (1.f - std::cos(halfDivision)) / std::sin(halfDivision))};
+        if (direction == NVG_CCW)
+        {
+            kappa = -kappa;
+        }
+
+        float previousX{}, previousY{}, previousTangentX{}, previousTangentY{};
+        for (int division = 0; division <= divisions; ++division)
+        {
+            const float angle{startAngle + sweep * (static_cast<float>(division) / static_cast<float>(divisions))};
+            const float dx{std::cos(angle)};
+            const float dy{std::sin(angle)};
+            const float pointX{x + dx * radius};
+            const float pointY{y + dy * radius};
+            const float tangentX{-dy * radius * kappa};
+            const float tangentY{dx * radius * kappa};
+
+            if (division == 0)
+            {
+                if (m_path.IsEmpty())
+                {
+                    PathMoveTo(pointX, pointY);
+                }
+                else
+                {
+                    PathLineTo(pointX, pointY);
+                }
+            }
+            else
+            {
+                PathBezierTo(previousX + previousTangentX, previousY + previousTangentY, pointX - tangentX, pointY - tangentY, pointX, pointY);
+            }
+
+            previousX = pointX;
+            previousY = pointY;
+            previousTangentX = tangentX;
+            previousTangentY = tangentY;
+        }
+    }
+
+    void Context::StrokeCanvasPath(const CanvasPath& path)
+    {
+        float transform[6];
+        nvgCurrentTransform(m_nvg, transform);
+        const float scale{GetAverageScale(transform)};
+
+        // Stroke paints are put in the current space when they are set, so the path in canvas pixels can be stroked
+        // without a transform, with the line width and dashes scaled as the transform would scale them.
+        ApplyStrokeStyle();
+        nvgSave(m_nvg);
+        nvgResetTransform(m_nvg);
+        nvgStrokeWidth(m_nvg, m_lineWidth * scale);
+        nvgBeginPath(m_nvg);
+        if (m_lineDash.empty())
+        {
+            path.Append(m_nvg);
+        }
+        else
+        {
+            path.AppendDashes(m_nvg, m_lineDash, m_lineDashOffset, scale);
+        }
+        nvgStroke(m_nvg);
+
+        // Stroking doesn't consume the current path.
+        nvgBeginPath(m_nvg);
+        m_path.Append(m_nvg);
+        nvgRestore(m_nvg);
+    }
 
-            nvgText(m_nvg, x, y, text.c_str(), nullptr);
-            SetDirty();
+    void Context::AddDamage(Bounds bounds, bool clipped)
+    {
+        if (clipped && m_isClipped)
+        {
+            bounds.Intersect(m_clipBounds);
         }
+
+        // Antialiasing reaches a pixel past the geometry.
+        bounds.Expand(1.f);
+        m_damage.Add(bounds);
+
+        ++m_contentVersion;
+        SetDirty();
+    }
+
+    float Context::GetStrokeExtent()
+    {
+        float transform[6];
+        nvgCurrentTransform(m_nvg, transform);
+        const float scale{std::max(std::sqrt(transform[0] * transform[0] + transform[1] * transform[1]), std::sqrt(transform[2] * transform[2] + transform[3] * transform[3]))};
+
+        // Miter joins reach the furthest from the path, up to the miter limit times half the line width.
+        return std::max(m_lineWidth, 1.f) * 0.5f * (m_lineJoin == NVG_MITER ? std::max(m_miterLimit, 1.f) : 1.f) * scale;
     }
 
     void Context::SetDirty()
@@ -409,10 +1022,44 @@ namespace Babylon::Polyfills::Internal
                 const auto width = m_canvas->GetWidth();
                 const auto height = m_canvas->GetHeight();
 
+                // Draws are scissored to the damaged bounds, unless the whole canvas was just cleared.
+                Bounds damage{m_damage};
+                m_damage = {};
+                damage.Intersect({0.f, 0.f, float(width), float(height)});
+                const bool scissored{!needClear && !damage.IsEmpty()};
+                if (scissored)
+                {
+                    // The frame buffer takes scissors with a bottom left origin, as WebGL does.
+                    const float left{std::floor(damage.MinX)};
+                    const float top{std::floor(damage.MinY)};
+                    const float right{std::ceil(damage.MaxX)};
+                    const float bottom{std::ceil(damage.MaxY)};
+                    frameBuffer.SetScissor(*encoder, left, float(height) - bottom, right - left, bottom - top);
+                }
+
+                // nanovg resets its state when a frame begins, the transform and line state of the context carry over.
+                float transform[6];
+                nvgCurrentTransform(m_nvg, transform);
                 nvgBeginFrame(m_nvg, float(width), float(height), 1.0f);
-                nvgSetFrameBufferAndEncoder(m_nvg, frameBuffer, encoder);
+                nvgSetFrameBufferAndEncoder(m_nvg, frameBuffer, encoder, m_graphicsContext.GetFrameNumber());
                 nvgEndFrame(m_nvg);
+                m_gradientImages.Flushed(m_nvg);
+                ReleaseCanvasImages();
+                nvgTransform(m_nvg, transform[0], transform[1], transform[2], transform[3], transform[4], transform[5]);
+                nvgStrokeWidth(m_nvg, m_lineWidth);
+                nvgLineJoin(m_nvg, m_lineJoin);
+                nvgMiterLimit(m_nvg, m_miterLimit);
+                nvgFontSize(m_nvg, m_fontSize);
+                if (scissored)
+                {
+                    frameBuffer.SetScissor(*encoder, 0.f, 0.f, 0.f, 0.f);
+                }
                 frameBuffer.Unbind(*encoder);
+                ReleasePutImages(m_graphicsContext.GetFrameNumber());
+
+                NVGrenderStats stats{};
+                nvgGetRenderStats(m_nvg, &stats);
+                m_graphicsContext.AddCanvasStats({static_cast<uint32_t>(stats.drawCalls), static_cast<uint32_t>(stats.unbatchedDrawCalls), static_cast<uint32_t>(stats.vertices), static_cast<uint32_t>(stats.overflows)});
                 m_dirty = false;
             }).then(arcana::inline_scheduler, *m_cancellationSource, [this, cancellationSource{m_cancellationSource}](const arcana::expected<void, std::exception_ptr>& result) {
                 if (!cancellationSource->cancelled() && result.has_error())
@@ -423,9 +1070,309 @@ namespace Babylon::Polyfills::Internal
         });
     }
 
-    void Context::PutImageData(const Napi::CallbackInfo&)
+    arcana::task<std::vector<uint8_t>, std::exception_ptr> Context::ReadPixelsAsync(int32_t x, int32_t y, uint32_t width, uint32_t height)
+    {
+        // Flushing also creates the frame buffer of a canvas that hasn't been drawn to yet.
+        SetDirty();
+
+        return arcana::make_task(m_update.Scheduler(), *m_cancellationSource, [this, x, y, width, height, cancellationSource{m_cancellationSource}]() {
+            return arcana::make_task(m_runtimeScheduler, *m_cancellationSource, [this, x, y, width, height, updateToken{m_update.GetUpdateToken()}, cancellationSource{m_cancellationSource}]() -> arcana::task<std::vector<uint8_t>, std::exception_ptr> {
+                // JS Thread
+                Graphics::FrameBuffer& frameBuffer = m_canvas->GetFrameBuffer();
+                const int64_t left{std::max<int64_t>(x, 0)};
+                const int64_t top{std::max<int64_t>(y, 0)};
+                const int64_t right{std::min<int64_t>(int64_t{x} + width, frameBuffer.Width())};
+                const int64_t bottom{std::min<int64_t>(int64_t{y} + height, frameBuffer.Height())};
+                if (left >= right || top >= bottom)
+                {
+                    return arcana::task_from_result<std::exception_ptr>(std::vector<uint8_t>(static_cast<size_t>(width) * height * 4));
+                }
+
+                const auto readWidth{static_cast<uint16_t>(right - left)};
+                const auto readHeight{static_cast<uint16_t>(bottom - top)};
+                const ReadbackTexture texture{AcquireReadbackTexture(readWidth, readHeight)};
+
+                // Render targets are stored bottom up when the origin is at the bottom left, so the rows are counted from the bottom.
+                const bool flip{bgfx::getCaps()->originBottomLeft};
+                const auto sourceY{static_cast<uint16_t>(flip ? frameBuffer.Height() - bottom : top)};
+                bgfx::Encoder* encoder = m_update.GetUpdateToken().GetEncoder();
+                encoder->blit(Graphics::DeviceContext::GetBlitViewId(), texture.Handle, /*dstMip*/ 0, /*dstX*/ 0, /*dstY*/ 0, /*dstZ*/ 0, bgfx::getTexture(frameBuffer.Handle()), /*srcMip*/ 0, static_cast<uint16_t>(left), sourceY, /*srcZ*/ 0, readWidth, readHeight, /*depth*/ 0);
+
+                auto staging{std::make_shared<std::vector<uint8_t>>(AcquireStagingBuffer(static_cast<size_t>(readWidth) * readHeight * 4))};
+                return m_graphicsContext.ReadTextureAsync(texture.Handle, *staging)
+                    .then(m_runtimeScheduler, arcana::cancellation::none(), [this, x, y, width, height, left, top, readWidth, readHeight, flip, texture, staging, cancellationSource](const arcana::expected<void, std::exception_ptr>& result) {
+                        // JS Thread
+                        std::vector<uint8_t> pixels{};
+                        if (!result.has_error())
+                        {
+                            pixels.resize(static_cast<size_t>(width) * height * 4);
+                            for (uint32_t row = 0; row < readHeight; ++row)
+                            {
+                                const uint8_t* source{staging->data() + static_cast<size_t>(flip ? readHeight - 1 - row : row) * readWidth * 4};
+                                uint8_t* destination{pixels.data() + ((top - y + row) * width + (left - x)) * 4};
+                                for (uint32_t column = 0; column < readWidth; ++column, source += 4, destination += 4)
+                                {
+                                    Unpremultiply(source, destination);
+                                }
+                            }
+                        }
+
+                        if (!cancellationSource->cancelled())
+                        {
+                            ReleaseReadbackTexture(texture);
+                            ReleaseStagingBuffer(std::move(*staging));
+                        }
+
+                        if (result.has_error())
+                        {
+                            std::rethrow_exception(result.error());
+                        }
+
+                        return pixels;
+                    });
+            });
+        });
+    }
+
+    bool Context::IsSnapshotCurrent() const
+    {
+        // A canvas that was never drawn to is transparent black, which needs no read back.
+        return m_snapshot.Version == m_contentVersion && !m_snapshot.Pending
+            && (m_contentVersion == 0 || (m_snapshot.Width == m_canvas->GetWidth() && m_snapshot.Height == m_canvas->GetHeight()));
+    }
+
+    void Context::RefreshSnapshot()
+    {
+        if (m_snapshot.Pending || IsSnapshotCurrent())
+        {
+            return;
+        }
+
+        m_snapshot.Pending = true;
+        const uint32_t width{m_canvas->GetWidth()};
+        const uint32_t height{m_canvas->GetHeight()};
+        ReadPixelsAsync(0, 0, width, height)
+            .then(m_runtimeScheduler, arcana::cancellation::none(), [this, width, height, version{m_contentVersion}, cancellationSource{m_cancellationSource}](arcana::expected<std::vector<uint8_t>, std::exception_ptr> result) {
+                if (cancellationSource->cancelled())
+                {
+                    return;
+                }
+
+                // A failed read keeps the previous contents, and is tried again by the next getImageData.
+                m_snapshot.Pending = false;
+                if (!result.has_error())
+                {
+                    m_snapshot = {std::move(result.value()), width, height, version, false};
+                }
+            });
+    }
+
+    Napi::Value Context::CreateImageData(const Napi::CallbackInfo& info)
+    {
+        if (info[0].IsObject())
+        {
+            const auto* imageData{ImageData::Unwrap(info[0].As<Napi::Object>())};
+            return ImageData::CreateInstance(info.Env(), imageData->GetWidth(), imageData->GetHeight());
+        }
+
+        const auto width = static_cast<uint32_t>(std::abs(info[0].As<Napi::Number>().Int32Value()));
+        const auto height = static_cast<uint32_t>(std::abs(info[1].As<Napi::Number>().Int32Value()));
+        return ImageData::CreateInstance(info.Env(), width, height);
+    }
+
+    void Context::PutImageData(const Napi::CallbackInfo& info)
+    {
+        auto* imageData{ImageData::Unwrap(info[0].As<Napi::Object>())};
+        const int64_t dx{info[1].As<Napi::Number>().Int32Value()};
+        const int64_t dy{info[2].As<Napi::Number>().Int32Value()};
+
+        // Only the dirty rectangle of the image data is uploaded and drawn.
+        int64_t dirtyX{0};
+        int64_t dirtyY{0};
+        int64_t dirtyWidth{imageData->GetWidth()};
+        int64_t dirtyHeight{imageData->GetHeight()};
+        if (info.Length() >= 7)
+        {
+            dirtyX = info[3].As<Napi::Number>().Int32Value();
+            dirtyY = info[4].As<Napi::Number>().Int32Value();
+            dirtyWidth = info[5].As<Napi::Number>().Int32Value();
+            dirtyHeight = info[6].As<Napi::Number>().Int32Value();
+            NormalizeRect(dirtyX, dirtyY, dirtyWidth, dirtyHeight);
+        }
+
+        const int64_t left{std::max<int64_t>(dirtyX, 0)};
+        const int64_t top{std::max<int64_t>(dirtyY, 0)};
+        const int64_t width{std::min<int64_t>(dirtyX + dirtyWidth, imageData->GetWidth()) - left};
+        const int64_t height{std::min<int64_t>(dirtyY + dirtyHeight, imageData->GetHeight()) - top};
+        if (width <= 0 || height <= 0)
+        {
+            return;
+        }
+
+        std::vector<uint8_t> pixels{AcquireStagingBuffer(static_cast<size_t>(width) * height * 4)};
+        CopyPixels(imageData->GetPixels(), imageData->GetWidth(), imageData->GetHeight(), left, top, pixels.data(), static_cast<uint32_t>(width), static_cast<uint32_t>(height), 0, 0, width, height);
+        const int image{AcquirePutImage(static_cast<int>(width), static_cast<int>(height), pixels.data())};
+
+        // The pixels replace the canvas contents as they are, whatever the transform, clipping, alpha and compositing.
+        const auto x{static_cast<float>(dx + left)};
+        const auto y{static_cast<float>(dy + top)};
+        nvgSave(m_nvg);
+        nvgReset(m_nvg);
+        nvgShapeAntiAlias(m_nvg, 0);
+        nvgGlobalCompositeOperation(m_nvg, NVG_COPY);
+        nvgBeginPath(m_nvg);
+        nvgRect(m_nvg, x, y, static_cast<float>(width), static_cast<float>(height));
+        nvgFillPaint(m_nvg, nvgImagePattern(m_nvg, x, y, static_cast<float>(width), static_cast<float>(height), 0.f, image, 1.f));
+        nvgFill(m_nvg);
+        nvgRestore(m_nvg);
+        PathBegin();
+
+        // An up to date snapshot stays up to date, so that getImageData sees the put right away.
+        const bool snapshotCurrent{IsSnapshotCurrent()};
+        Bounds bounds{};
+        bounds.Add(x, y);
+        bounds.Add(x + static_cast<float>(width), y + static_cast<float>(height));
+        AddDamage(bounds, false);
+        if (snapshotCurrent)
+        {
+            if (m_snapshot.Width != m_canvas->GetWidth() || m_snapshot.Height != m_canvas->GetHeight())
+            {
+                m_snapshot.Width = m_canvas->GetWidth();
+                m_snapshot.Height = m_canvas->GetHeight();
+                m_snapshot.Pixels.assign(static_cast<size_t>(m_snapshot.Width) * m_snapshot.Height * 4, 0);
+            }
+
+            CopyPixels(pixels.data(), static_cast<uint32_t>(width), static_cast<uint32_t>(height), 0, 0, m_snapshot.Pixels.data(), m_snapshot.Width, m_snapshot.Height, dx + left, dy + top, width, height);
+            m_snapshot.Version = m_contentVersion;
+        }
+
+        ReleaseStagingBuffer(std::move(pixels));
+    }
+
+    int Context::AcquirePutImage(int width, int height, const uint8_t* pixels)
+    {
+        const uint32_t frameNumber{m_graphicsContext.GetFrameNumber()};
+        for (auto& putImage : m_putImages)
+        {
+            if (putImage.Width == width && putImage.Height == height && putImage.FrameNumber < frameNumber)
+            {
+                putImage.FrameNumber = PUT_IMAGE_PENDING;
+                nvgUpdateImage(m_nvg, putImage.Image, pixels);
+                return putImage.Image;
+            }
+        }
+
+        const int image{nvgCreateImageRGBA(m_nvg, width, height, 0, pixels)};
+        m_putImages.push_back({image, width, height, PUT_IMAGE_PENDING});
+        return image;
+    }
+
+    void Context::ReleaseCanvasImages()
+    {
+        for (auto it = m_canvasImages.begin(); it != m_canvasImages.end();)
+        {
+            if (it->second.Lifetime.expired())
+            {
+                nvgDeleteImage(m_nvg, it->second.NvgImage);
+                it = m_canvasImages.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        for (auto& image : m_retiredCanvasImages)
+        {
+            nvgDeleteImage(m_nvg, image.NvgImage);
+        }
+        m_retiredCanvasImages.clear();
+    }
+
+    void Context::ReleasePutImages(uint32_t frameNumber)
+    {
+        for (auto& putImage : m_putImages)
+        {
+            if (putImage.FrameNumber == PUT_IMAGE_PENDING)
+            {
+                putImage.FrameNumber = frameNumber;
+            }
+        }
+
+        // Images of earlier frames beyond the few kept for reuse are deleted.
+        for (auto it = m_putImages.begin(); it != m_putImages.end() && m_putImages.size() > MAX_IDLE_READBACK_RESOURCES;)
+        {
+            if (it->FrameNumber < frameNumber)
+            {
+                nvgDeleteImage(m_nvg, it->Image);
+                it = m_putImages.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    Context::ReadbackTexture Context::AcquireReadbackTexture(uint16_t width, uint16_t height)
+    {
+        const auto deviceId{m_graphicsContext.GetDeviceId()};
+
+        // Handles from before a device reset are stale and are dropped without being destroyed.
+        m_readbackTextures.erase(std::remove_if(m_readbackTextures.begin(), m_readbackTextures.end(), [deviceId](const ReadbackTexture& texture) {
+            return texture.DeviceId != deviceId;
+        }), m_readbackTextures.end());
+
+        auto it{std::find_if(m_readbackTextures.begin(), m_readbackTextures.end(), [width, height](const ReadbackTexture& texture) {
+            return texture.Width == width && texture.Height == height;
+        })};
+
+        if (it != m_readbackTextures.end())
+        {
+            ReadbackTexture texture{*it};
+            m_readbackTextures.erase(it);
+            return texture;
+        }
+
+        return {bgfx::createTexture2D(width, height, /*hasMips*/ false, /*numLayers*/ 1, bgfx::TextureFormat::RGBA8, BGFX_TEXTURE_BLIT_DST | BGFX_TEXTURE_READ_BACK), width, height, deviceId};
+    }
+
+    void Context::ReleaseReadbackTexture(ReadbackTexture texture)
+    {
+        if (texture.DeviceId != m_graphicsContext.GetDeviceId())
+        {
+            return;
+        }
+
+        m_readbackTextures.push_back(texture);
+
+        // Keep only the most recently used readback textures.
+        if (m_readbackTextures.size() > MAX_IDLE_READBACK_RESOURCES)
+        {
+            bgfx::destroy(m_readbackTextures.front().Handle);
+            m_readbackTextures.erase(m_readbackTextures.begin());
+        }
+    }
+
+    std::vector<uint8_t> Context::AcquireStagingBuffer(size_t size)
     {
-        throw std::runtime_error{"not implemented"};
+        std::vector<uint8_t> buffer{};
+        if (!m_stagingBuffers.empty())
+        {
+            buffer = std::move(m_stagingBuffers.back());
+            m_stagingBuffers.pop_back();
+        }
+
+        buffer.resize(size);
+        return buffer;
+    }
+
+    void Context::ReleaseStagingBuffer(std::vector<uint8_t> buffer)
+    {
+        if (buffer.capacity() != 0 && m_stagingBuffers.size() < MAX_IDLE_READBACK_RESOURCES)
+        {
+            m_stagingBuffers.push_back(std::move(buffer));
+        }
     }
 
     void Context::Arc(const Napi::CallbackInfo& info)
@@ -436,26 +1383,32 @@ namespace Babylon::Polyfills::Internal
         const auto startAngle = static_cast<float>(info[3].As<Napi::Number>().DoubleValue());
         const auto endAngle = static_cast<float>(info[4].As<Napi::Number>().DoubleValue());
         const NVGwinding winding = (info.Length() == 6 && info[5].As<Napi::Boolean>()) ? NVGwinding::NVG_CCW : NVGwinding::NVG_CW;
-        nvgArc(m_nvg, x, y, radius, startAngle, endAngle, winding);
+        PathArc(x, y, radius, startAngle, endAngle, winding);
         SetDirty();
     }
 
     void Context::DrawImage(const Napi::CallbackInfo& info)
     {
-        const NativeCanvasImage* canvasImage = NativeCanvasImage::Unwrap(info[0].As<Napi::Object>());
+        NativeCanvasImage* canvasImage = NativeCanvasImage::Unwrap(info[0].As<Napi::Object>());
 
-        int imageIndex{-1};
-        const auto nvgImageIter = m_nvgImageIndices.find(canvasImage);
-        if (nvgImageIter == m_nvgImageIndices.end())
+        auto texture{canvasImage->GetTexture()};
+        if (!texture)
         {
-            imageIndex = canvasImage->CreateNVGImageForContext(m_nvg);
-            m_nvgImageIndices.try_emplace(canvasImage, imageIndex);
+            return;
         }
-        else
+
+        // The nanovg image is made again when the image was loaded again since it was last drawn, or when the entry was
+        // left by a destroyed image at the same address.
+        auto& image{m_canvasImages[canvasImage]};
+        if (image.Texture != texture || image.Lifetime.expired())
         {
-            imageIndex = nvgImageIter->second;
+            if (image.Texture)
+            {
+                m_retiredCanvasImages.push_back(std::move(image));
+            }
+            image = {nvgCreateImageFromHandle(m_nvg, texture->Handle(), texture->Width(), texture->Height(), 0), std::move(texture), canvasImage->GetLifetime()};
         }
-        assert(imageIndex != -1);
+        const int imageIndex{image.NvgImage};
 
         if (info.Length() == 3)
         {
@@ -468,13 +1421,13 @@ namespace Babylon::Polyfills::Internal
 
             if (!m_isClipped)
             {
-                nvgBeginPath(m_nvg);
+                PathBegin();
             }
 
-            nvgRect(m_nvg, dx, dy, width, height);
+            PathRect(dx, dy, width, height);
             nvgFillPaint(m_nvg, imagePaint);
             nvgFill(m_nvg);
-            SetDirty();
+            AddDamage(m_pathBounds);
         }
         else if (info.Length() == 5)
         {
@@ -487,13 +1440,13 @@ namespace Babylon::Polyfills::Internal
 
             if (!m_isClipped)
             {
-                nvgBeginPath(m_nvg);
+                PathBegin();
             }
 
-            nvgRect(m_nvg, dx, dy, dWidth, dHeight);
+            PathRect(dx, dy, dWidth, dHeight);
             nvgFillPaint(m_nvg, imagePaint);
             nvgFill(m_nvg);
-            SetDirty();
+            AddDamage(m_pathBounds);
         }
         else if (info.Length() == 9)
         {
@@ -512,13 +1465,13 @@ namespace Babylon::Polyfills::Internal
 
             if (!m_isClipped)
             {
-                nvgBeginPath(m_nvg);
+                PathBegin();
             }
 
-            nvgRect(m_nvg, dx, dy, dWidth, dHeight);
+            PathRect(dx, dy, dWidth, dHeight);
             nvgFillPaint(m_nvg, imagePaint);
             nvgFill(m_nvg);
-            SetDirty();
+            AddDamage(m_pathBounds);
         }
         else
         {
@@ -528,53 +1481,235 @@ namespace Babylon::Polyfills::Internal
 
     Napi::Value Context::GetImageData(const Napi::CallbackInfo& info)
     {
-        // TODO: support source x and y
-        //const auto sx = info[0].As<Napi::Number>().Uint32Value();
-        //const auto sy = info[1].As<Napi::Number>().Uint32Value();
-        const auto sw = info[2].As<Napi::Number>().Uint32Value();
-        const auto sh = info[3].As<Napi::Number>().Uint32Value();
+        int64_t sx{info[0].As<Napi::Number>().Int32Value()};
+        int64_t sy{info[1].As<Napi::Number>().Int32Value()};
+        int64_t sw{info[2].As<Napi::Number>().Int32Value()};
+        int64_t sh{info[3].As<Napi::Number>().Int32Value()};
+        NormalizeRect(sx, sy, sw, sh);
+
+        // Returning out of date contents would go unnoticed, so the read back started here has to be waited for.
+        if (!IsSnapshotCurrent())
+        {
+            RefreshSnapshot();
+            throw Napi::Error::New(info.Env(), "The canvas contents are not read back yet, use getImageDataAsync or wait for imageDataReady");
+        }
+
+        auto imageData{ImageData::CreateInstance(info.Env(), static_cast<uint32_t>(sw), static_cast<uint32_t>(sh))};
+        CopyPixels(m_snapshot.Pixels.data(), m_snapshot.Width, m_snapshot.Height, sx, sy, ImageData::Unwrap(imageData.As<Napi::Object>())->GetPixels(), static_cast<uint32_t>(sw), static_cast<uint32_t>(sh), 0, 0, sw, sh);
+        return imageData;
+    }
+
+    Napi::Value Context::GetImageDataReady(const Napi::CallbackInfo& info)
+    {
+        // Reading the flag starts the read back, so that polling it eventually succeeds.
+        const bool ready{IsSnapshotCurrent()};
+        if (!ready)
+        {
+            RefreshSnapshot();
+        }
+
+        return Napi::Boolean::New(info.Env(), ready);
+    }
+
+    Napi::Value Context::GetImageDataAsync(const Napi::CallbackInfo& info)
+    {
+        int64_t sx{info[0].As<Napi::Number>().Int32Value()};
+        int64_t sy{info[1].As<Napi::Number>().Int32Value()};
+        int64_t sw{info[2].As<Napi::Number>().Int32Value()};
+        int64_t sh{info[3].As<Napi::Number>().Int32Value()};
+        NormalizeRect(sx, sy, sw, sh);
+
+        const auto env{info.Env()};
+        const auto deferred{Napi::Promise::Deferred::New(env)};
+        auto imageData{ImageData::CreateInstance(env, static_cast<uint32_t>(sw), static_cast<uint32_t>(sh)).As<Napi::Object>()};
+
+        ReadPixelsAsync(static_cast<int32_t>(sx), static_cast<int32_t>(sy), static_cast<uint32_t>(sw), static_cast<uint32_t>(sh))
+            .then(m_runtimeScheduler, arcana::cancellation::none(), [env, deferred, imageDataRef{Napi::Persistent(imageData)}](const arcana::expected<std::vector<uint8_t>, std::exception_ptr>& result) mutable {
+                if (result.has_error())
+                {
+                    deferred.Reject(Napi::Error::New(env, result.error()).Value());
+                    return;
+                }
+
+                std::memcpy(ImageData::Unwrap(imageDataRef.Value())->GetPixels(), result.value().data(), result.value().size());
+                deferred.Resolve(imageDataRef.Value());
+            });
 
-        return ImageData::CreateInstance(info.Env(), this, sw, sh);
+        return deferred.Promise();
     }
 
     void Context::SetLineDash(const Napi::CallbackInfo& info)
     {
-        throw Napi::Error::New(info.Env(), "not implemented");
+        const auto segments{info[0].As<Napi::Array>()};
+        std::vector<float> lineDash(segments.Length());
+        for (uint32_t index = 0; index < segments.Length(); ++index)
+        {
+            // Lists with a negative or non finite length are ignored.
+            const float length{segments.Get(index).As<Napi::Number>().FloatValue()};
+            if (!std::isfinite(length) || length < 0.f)
+            {
+                return;
+            }
+            lineDash[index] = length;
+        }
+
+        // Odd lists are repeated to get an even number of dashes and gaps.
+        if (lineDash.size() % 2 != 0)
+        {
+            lineDash.insert(lineDash.end(), lineDash.begin(), lineDash.end());
+        }
+
+        m_lineDash = std::move(lineDash);
     }
 
-    void Context::StrokeText(const Napi::CallbackInfo& info)
+    Napi::Value Context::GetLineDash(const Napi::CallbackInfo& info)
     {
-        throw Napi::Error::New(info.Env(), "not implemented");
+        auto segments{Napi::Array::New(info.Env(), m_lineDash.size())};
+        for (uint32_t index = 0; index < m_lineDash.size(); ++index)
+        {
+            segments.Set(index, Napi::Value::From(info.Env(), m_lineDash[index]));
+        }
+        return segments;
+    }
+
+    Napi::Value Context::GetLineDashOffset(const Napi::CallbackInfo&)
+    {
+        return Napi::Value::From(Env(), m_lineDashOffset);
+    }
+
+    void Context::SetLineDashOffset(const Napi::CallbackInfo&, const Napi::Value& value)
+    {
+        const float offset{value.As<Napi::Number>().FloatValue()};
+        if (std::isfinite(offset))
+        {
+            m_lineDashOffset = offset;
+        }
     }
 
     Napi::Value Context::CreateLinearGradient(const Napi::CallbackInfo& info)
     {
-        throw Napi::Error::New(info.Env(), "not implemented");
+        const auto x0 = info[0].As<Napi::Number>().FloatValue();
+        const auto y0 = info[1].As<Napi::Number>().FloatValue();
+        const auto x1 = info[2].As<Napi::Number>().FloatValue();
+        const auto y1 = info[3].As<Napi::Number>().FloatValue();
+
+        return CanvasGradient::CreateLinear(info.Env(), x0, y0, x1, y1);
+    }
+
+    Napi::Value Context::CreateRadialGradient(const Napi::CallbackInfo& info)
+    {
+        const auto x0 = info[0].As<Napi::Number>().FloatValue();
+        const auto y0 = info[1].As<Napi::Number>().FloatValue();
+        const auto r0 = info[2].As<Napi::Number>().FloatValue();
+        const auto x1 = info[3].As<Napi::Number>().FloatValue();
+        const auto y1 = info[4].As<Napi::Number>().FloatValue();
+        const auto r1 = info[5].As<Napi::Number>().FloatValue();
+
+        return CanvasGradient::CreateRadial(info.Env(), x0, y0, r0, x1, y1, r1);
     }
 
     void Context::SetTransform(const Napi::CallbackInfo& info)
     {
-        throw Napi::Error::New(info.Env(), "not implemented");
+        // Takes the six matrix values, or an object with them such as a DOMMatrix. Without arguments, resets the transform.
+        float matrix[6]{1.f, 0.f, 0.f, 1.f, 0.f, 0.f};
+        if (info.Length() >= 6)
+        {
+            for (size_t index = 0; index < 6; ++index)
+            {
+                matrix[index] = info[index].As<Napi::Number>().FloatValue();
+            }
+        }
+        else if (info.Length() > 0 && info[0].IsObject())
+        {
+            const auto object{info[0].As<Napi::Object>()};
+            const char* names[6]{"a", "b", "c", "d", "e", "f"};
+            for (size_t index = 0; index < 6; ++index)
+            {
+                if (object.Has(names[index]))
+                {
+                    matrix[index] = object.Get(names[index]).As<Napi::Number>().FloatValue();
+                }
+            }
+        }
+
+        nvgResetTransform(m_nvg);
+        nvgTransform(m_nvg, matrix[0], matrix[1], matrix[2], matrix[3], matrix[4], matrix[5]);
+        SetDirty();
     }
 
-    Napi::Value Context::GetLineJoin(const Napi::CallbackInfo& info)
+    void Context::Transform(const Napi::CallbackInfo& info)
     {
-        throw Napi::Error::New(info.Env(), "not implemented");
+        const auto a = info[0].As<Napi::Number>().FloatValue();
+        const auto b = info[1].As<Napi::Number>().FloatValue();
+        const auto c = info[2].As<Napi::Number>().FloatValue();
+        const auto d = info[3].As<Napi::Number>().FloatValue();
+        const auto e = info[4].As<Napi::Number>().FloatValue();
+        const auto f = info[5].As<Napi::Number>().FloatValue();
+        nvgTransform(m_nvg, a, b, c, d, e, f);
+        SetDirty();
     }
 
-    void Context::SetLineJoin(const Napi::CallbackInfo& info, const Napi::Value& value)
+    void Context::ResetTransform(const Napi::CallbackInfo&)
     {
-        throw Napi::Error::New(info.Env(), "not implemented");
+        nvgResetTransform(m_nvg);
+        SetDirty();
     }
 
-    Napi::Value Context::GetMiterLimit(const Napi::CallbackInfo& info)
+    Napi::Value Context::GetLineJoin(const Napi::CallbackInfo&)
     {
-        throw Napi::Error::New(info.Env(), "not implemented");
+        switch (m_lineJoin)
+        {
+            case NVG_ROUND:
+                return Napi::Value::From(Env(), "round");
+            case NVG_BEVEL:
+                return Napi::Value::From(Env(), "bevel");
+            default:
+                return Napi::Value::From(Env(), "miter");
+        }
     }
 
-    void Context::SetMiterLimit(const Napi::CallbackInfo& info, const Napi::Value& value)
+    void Context::SetLineJoin(const Napi::CallbackInfo&, const Napi::Value& value)
     {
-        throw Napi::Error::New(info.Env(), "not implemented");
+        // Unknown values are ignored.
+        const std::string lineJoin{value.As<Napi::String>().Utf8Value()};
+        if (lineJoin == "round")
+        {
+            m_lineJoin = NVG_ROUND;
+        }
+        else if (lineJoin == "bevel")
+        {
+            m_lineJoin = NVG_BEVEL;
+        }
+        else if (lineJoin == "miter")
+        {
+            m_lineJoin = NVG_MITER;
+        }
+        else
+        {
+            return;
+        }
+
+        nvgLineJoin(m_nvg, m_lineJoin);
+        SetDirty();
+    }
+
+    Napi::Value Context::GetMiterLimit(const Napi::CallbackInfo&)
+    {
+        return Napi::Value::From(Env(), m_miterLimit);
+    }
+
+    void Context::SetMiterLimit(const Napi::CallbackInfo&, const Napi::Value& value)
+    {
+        // Values that aren't positive are ignored.
+        const float miterLimit{value.As<Napi::Number>().FloatValue()};
+        if (!std::isfinite(miterLimit) || miterLimit <= 0.f)
+        {
+            return;
+        }
+
+        m_miterLimit = miterLimit;
+        nvgMiterLimit(m_nvg, m_miterLimit);
+        SetDirty();
     }
 
     Napi::Value Context::GetFont(const Napi::CallbackInfo& info)
@@ -591,34 +1726,49 @@ namespace Babylon::Polyfills::Internal
 
         const std::string fontOptions = value.ToString();
 
-        // Default font id, and font size values.
-        // TODO: Determine better way of signaling to user that font specified is invalid.
-        m_currentFontId = -1;
-        int fontSize = 16;
-
-        // Regex to parse font styling information. For now we are only capturing font size (capture group 3) and font family name (capture group 4).
-        static const std::regex fontStyleRegex("([[a-zA-Z]+\\s+)*((\\d+)px\\s+)?(\\w+)");
-        std::smatch fontStyleMatch;
-
-        // Perform the actual regex_match.
-        if (std::regex_match(fontOptions, fontStyleMatch, fontStyleRegex))
+        auto it{m_resolvedFonts.find(fontOptions)};
+        if (it == m_resolvedFonts.end())
         {
-            // Check if font size was specified.
-            if (fontStyleMatch[3].matched)
+            if (m_resolvedFonts.size() >= FONT_MEMO_CAPACITY)
             {
-                fontSize = std::stoi(fontStyleMatch[3]);
+                m_resolvedFonts.clear();
             }
 
-            // Check if the specified font family name is valid, and if so assign the current font id.
-            if (m_fonts.find(fontStyleMatch[4]) != m_fonts.end())
+            it = m_resolvedFonts.emplace(fontOptions, ResolveFont(fontOptions)).first;
+        }
+
+        // TODO: Determine better way of signaling to user that font specified is invalid.
+        m_currentFontId = it->second.FontId;
+        if (m_currentFontId >= 0)
+        {
+            m_font = fontOptions;
+        }
+
+        // Set font size on the current context.
+        m_fontSize = it->second.Size;
+        nvgFontSize(m_nvg, m_fontSize);
+    }
+
+    Context::ResolvedFont Context::ResolveFont(const std::string& fontOptions) const
+    {
+        // The size is applied even when none of the families is loaded.
+        FontShorthand font{};
+        ResolvedFont resolved{-1, font.Size};
+        if (ParseFontShorthand(fontOptions, font))
+        {
+            resolved.Size = font.Size;
+            for (const auto family : font.Families)
             {
-                m_currentFontId = m_fonts.at(fontStyleMatch[4]);
-                m_font = fontOptions;
+                const auto fontIt{m_fonts.find(std::string{family})};
+                if (fontIt != m_fonts.end())
+                {
+                    resolved.FontId = fontIt->second;
+                    break;
+                }
             }
         }
 
-        // Set font size on the current context.
-        nvgFontSize(m_nvg, static_cast<float>(fontSize));
+        return resolved;
     }
 
     void Context::SetGlobalAlpha(const Napi::CallbackInfo& info, const Napi::Value& value)
@@ -4,8 +4,14 @@
 #include <Babylon/JsRuntimeScheduler.h>
 #include <Babylon/Graphics/DeviceContext.h>
 #include "Image.h"
+#include "Gradient.h"
+#include "Path.h"
+#include "TextCache.h"
 
-struct NVGcontext;
+#include <limits>
+#include <memory>
+
+struct stbtt_fontinfo;
 
 namespace Babylon::Polyfills::Internal
 {
@@ -43,10 +49,16 @@ namespace Babylon::Polyfills::Internal
         void Arc(const Napi::CallbackInfo&);
         void DrawImage(const Napi::CallbackInfo&);
         Napi::Value GetImageData(const Napi::CallbackInfo&);
+        Napi::Value GetImageDataAsync(const Napi::CallbackInfo&);
+        Napi::Value CreateImageData(const Napi::CallbackInfo&);
         void SetLineDash(const Napi::CallbackInfo&);
+        Napi::Value GetLineDash(const Napi::CallbackInfo&);
         void StrokeText(const Napi::CallbackInfo&);
         Napi::Value CreateLinearGradient(const Napi::CallbackInfo&);
+        Napi::Value CreateRadialGradient(const Napi::CallbackInfo&);
         void SetTransform(const Napi::CallbackInfo&);
+        void Transform(const Napi::CallbackInfo&);
+        void ResetTransform(const Napi::CallbackInfo&);
         void QuadraticCurveTo(const Napi::CallbackInfo&);
         Napi::Value GetFillStyle(const Napi::CallbackInfo&);
         void SetFillStyle(const Napi::CallbackInfo&, const Napi::Value& value);
@@ -58,6 +70,8 @@ namespace Babylon::Polyfills::Internal
         void SetLineJoin(const Napi::CallbackInfo&, const Napi::Value& value);
         Napi::Value GetMiterLimit(const Napi::CallbackInfo&);
         void SetMiterLimit(const Napi::CallbackInfo&, const Napi::Value& value);
+        Napi::Value GetLineDashOffset(const Napi::CallbackInfo&);
+        void SetLineDashOffset(const Napi::CallbackInfo&, const Napi::Value& value);
         Napi::Value GetFont(const Napi::CallbackInfo&);
         void SetFont(const Napi::CallbackInfo&, const Napi::Value& value);
         void SetGlobalAlpha(const Napi::CallbackInfo&, const Napi::Value& value);
@@ -70,22 +84,169 @@ namespace Babylon::Polyfills::Internal
         Napi::Value GetShadowOffsetY(const Napi::CallbackInfo&);
         void SetShadowOffsetY(const Napi::CallbackInfo&, const Napi::Value& value);
         Napi::Value GetCanvas(const Napi::CallbackInfo&);
+        Napi::Value GetImageDataReady(const Napi::CallbackInfo&);
         void Dispose(const Napi::CallbackInfo&);
         void Dispose();
         void SetDirty();
         void DeferredFlushFrame();
 
+        // Axis aligned bounds in canvas pixels.
+        struct Bounds
+        {
+            float MinX{std::numeric_limits<float>::max()};
+            float MinY{std::numeric_limits<float>::max()};
+            float MaxX{std::numeric_limits<float>::lowest()};
+            float MaxY{std::numeric_limits<float>::lowest()};
+
+            bool IsEmpty() const { return MinX >= MaxX || MinY >= MaxY; }
+            void Add(float x, float y);
+            void Add(const Bounds& other);
+            void Intersect(const Bounds& other);
+            void Expand(float amount);
+        };
+
+        // Flushes only draw to the bounds damaged since the previous flush, so that small changes to a large canvas cost
+        // in proportion to their area. The rest of the canvas keeps its contents, as flushes never clear it.
+        void AddToPath(float x, float y);
+        void AddRectToPath(float x, float y, float width, float height);
+        void AddDamage(Bounds bounds, bool clipped = true);
+        float GetStrokeExtent();
+        Bounds GetTextBounds(const TextCache::Layout& layout, float x, float y);
+        Bounds m_pathBounds{};
+        Bounds m_clipBounds{};
+        Bounds m_damage{};
+
+        // Path building goes through these, which give the commands to nanovg and record them in the current path.
+        void PathBegin();
+        void PathMoveTo(float x, float y);
+        void PathLineTo(float x, float y);
+        void PathBezierTo(float c1x, float c1y, float c2x, float c2y, float x, float y);
+        void PathClose();
+        void PathRect(float x, float y, float width, float height);
+        void PathArc(float x, float y, float radius, float startAngle, float endAngle, NVGwinding direction);
+        CanvasPath m_path{};
+
+        // Strokes a path recorded in canvas pixels, cutting it into dashes when there is a line dash, and gives the
+        // current path back to nanovg afterwards.
+        void StrokeCanvasPath(const CanvasPath& path);
+
+        // Glyph outlines stroked by strokeText, as nanovg only draws filled glyphs.
+        const stbtt_fontinfo* GetOutlineFont(int fontId);
+        std::map<int, std::unique_ptr<stbtt_fontinfo>> m_outlineFonts{};
+
+        // Reads a rectangle of the canvas once pending drawing is flushed, as unpremultiplied RGBA rows delivered on the
+        // JavaScript thread. Pixels outside of the canvas are transparent black.
+        arcana::task<std::vector<uint8_t>, std::exception_ptr> ReadPixelsAsync(int32_t x, int32_t y, uint32_t width, uint32_t height);
+
+        // getImageData can't wait for the GPU, so it copies from the contents of the whole canvas read back in the
+        // background, which are read again when drawing makes them out of date. It throws while they are, imageDataReady
+        // tells when they are current again and getImageDataAsync waits for them instead.
+        struct Snapshot
+        {
+            std::vector<uint8_t> Pixels;
+            uint32_t Width;
+            uint32_t Height;
+            uint64_t Version;
+            bool Pending;
+        };
+        Snapshot m_snapshot{};
+        uint64_t m_contentVersion{};
+        bool IsSnapshotCurrent() const;
+        void RefreshSnapshot();
+
+        // Readback textures and staging buffers are pooled so that frequent reads and puts don't create textures or allocate.
+        static constexpr size_t MAX_IDLE_READBACK_RESOURCES{4};
+        struct ReadbackTexture
+        {
+            bgfx::TextureHandle Handle{bgfx::kInvalidHandle};
+            uint16_t Width{};
+            uint16_t Height{};
+            uintptr_t DeviceId{};
+        };
+        ReadbackTexture AcquireReadbackTexture(uint16_t width, uint16_t height);
+        void ReleaseReadbackTexture(ReadbackTexture texture);
+        std::vector<uint8_t> AcquireStagingBuffer(size_t size);
+        void ReleaseStagingBuffer(std::vector<uint8_t> buffer);
+        std::vector<ReadbackTexture> m_readbackTextures{};
+        std::vector<std::vector<uint8_t>> m_stagingBuffers{};
+
+        // Images that putImageData uploads to. They are drawn by nanovg so that puts stay in order with the other drawing,
+        // and an image is only updated again once the frame that draws it has been submitted.
+        struct PutImage
+        {
+            int Image;
+            int Width;
+            int Height;
+            uint32_t FrameNumber;
+        };
+        static constexpr uint32_t PUT_IMAGE_PENDING{std::numeric_limits<uint32_t>::max()};
+        int AcquirePutImage(int width, int height, const uint8_t* pixels);
+        void ReleasePutImages(uint32_t frameNumber);
+        std::vector<PutImage> m_putImages{};
+
+        struct ResolvedFont
+        {
+            int FontId;
+            float Size;
+        };
+        ResolvedFont ResolveFont(const std::string& fontOptions) const;
+
+        // A fill or stroke style is either a CSS color or a CanvasGradient, which is kept alive while it is in use.
+        struct PaintStyle
+        {
+            std::string Color{"#000000"};
+            NVGcolor ParsedColor{nvgRGBA(0, 0, 0, 255)};
+            std::shared_ptr<Napi::ObjectReference> Gradient{};
+        };
+        PaintStyle ToPaintStyle(const Napi::Value& value) const;
+        Napi::Value FromPaintStyle(const PaintStyle& style) const;
+
+        // Gradients are in the space current at draw time, so styles are applied right before filling or stroking.
+        void ApplyFillStyle();
+        void ApplyStrokeStyle();
+
+        // Selects the current font in nanovg and returns its id, or -1 when no font is loaded.
+        int SelectFont();
+        const TextCache::Layout& GetTextLayout(int fontId, const std::string& text);
+
         NativeCanvas* m_canvas;
         NVGcontext* m_nvg;
 
         std::string m_font{};
-        std::string m_fillStyle{};
-        std::string m_strokeStyle{};
-        float m_lineWidth{0.f};
+        PaintStyle m_fillStyle{};
+        PaintStyle m_strokeStyle{};
+        float m_lineWidth{1.f};
+        int m_lineJoin{NVG_MITER};
+        float m_miterLimit{10.f};
+        std::vector<float> m_lineDash{};
+        float m_lineDashOffset{0.f};
         float m_globalAlpha{1.f};
 
         std::map<std::string, int> m_fonts;
+        std::map<std::string, Polyfills::Canvas::Impl::FontData> m_fontData;
         int m_currentFontId{-1};
+        float m_fontSize{16.f};
+
+        // The font, paint and line styles are part of the state saved and restored with the nanovg state.
+        struct SavedState
+        {
+            std::string Font;
+            int FontId;
+            float FontSize;
+            PaintStyle FillStyle;
+            PaintStyle StrokeStyle;
+            float LineWidth;
+            int LineJoin;
+            float MiterLimit;
+            std::vector<float> LineDash;
+            float LineDashOffset;
+        };
+        std::vector<SavedState> m_savedStates{};
+
+        TextCache m_textCache;
+
+        // Font strings already parsed, with the font id and size they resolve to.
+        std::unordered_map<std::string, ResolvedFont> m_resolvedFonts{};
 
         Graphics::DeviceContext& m_graphicsContext;
         Graphics::Update m_update;
@@ -101,7 +262,19 @@ namespace Babylon::Polyfills::Internal
         std::shared_ptr<arcana::cancellation_source> m_cancellationSource{};
         JsRuntimeScheduler m_runtimeScheduler;
 
-        std::unordered_map<const NativeCanvasImage*, int> m_nvgImageIndices;
+        // nanovg images of the canvas images drawn by the context, which draw the textures shared by all contexts. Images
+        // may still be drawn by the commands recorded since the last flush, so the ones that were replaced or whose canvas
+        // image is gone are only deleted once the next flush submitted those commands.
+        struct CanvasImage
+        {
+            int NvgImage;
+            std::shared_ptr<Graphics::Texture> Texture;
+            std::weak_ptr<const void> Lifetime;
+        };
+        void ReleaseCanvasImages();
+        std::unordered_map<const NativeCanvasImage*, CanvasImage> m_canvasImages;
+        std::vector<CanvasImage> m_retiredCanvasImages{};
+        GradientImageCache m_gradientImages{};
 
         void FlushGraphicResources() override;
 
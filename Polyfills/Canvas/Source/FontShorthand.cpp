@@ -0,0 +1,164 @@
+#include "FontShorthand.h"
+
+namespace
+{
+    constexpr float DEFAULT_FONT_SIZE{16.f};
+
+    bool IsSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f';
+    }
+
+    std::string_view TrimStart(std::string_view text)
+    {
+        size_t start{0};
+        while (start < text.size() && IsSpace(text[start]))
+        {
+            ++start;
+        }
+        return text.substr(start);
+    }
+
+    std::string_view Trim(std::string_view text)
+    {
+        text = TrimStart(text);
+        size_t end{text.size()};
+        while (end > 0 && IsSpace(text[end - 1]))
+        {
+            --end;
+        }
+        return text.substr(0, end);
+    }
+
+    std::string_view NextToken(std::string_view& text)
+    {
+        size_t end{0};
+        while (end < text.size() && !IsSpace(text[end]))
+        {
+            ++end;
+        }
+
+        const std::string_view token{text.substr(0, end)};
+        text = TrimStart(text.substr(end));
+        return token;
+    }
+
+    // Parses a length such as "24px", "12.5pt" or "1.5em" into pixels.
+    bool ParseFontSize(std::string_view token, float& size)
+    {
+        size_t index{0};
+        float value{0.f};
+        bool hasDigits{false};
+
+        for (; index < token.size() && token[index] >= '0' && token[index] <= '9'; ++index)
+        {
+            value = value * 10.f + static_cast<float>(token[index] - '0');
+            hasDigits = true;
+        }
+
+        if (index < token.size() && token[index] == '.')
+        {
+            float scale{0.1f};
+            for (++index; index < token.size() && token[index] >= '0' && token[index] <= '9'; ++index)
+            {
+                value += static_cast<float>(token[index] - '0') * scale;
+                scale *= 0.1f;
+                hasDigits = true;
+            }
+        }
+
+        if (!hasDigits)
+        {
+            return false;
+        }
+
+        const std::string_view unit{token.substr(index)};
+        if (unit == "px")
+        {
+            size = value;
+        }
+        else if (unit == "pt")
+        {
+            size = value * 4.f / 3.f;
+        }
+        else if (unit == "em" || unit == "rem")
+        {
+            size = value * DEFAULT_FONT_SIZE;
+        }
+        else if (unit == "%")
+        {
+            size = value * DEFAULT_FONT_SIZE / 100.f;
+        }
+        else
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    void ParseFamilies(std::string_view text, std::vector<std::string_view>& families)
+    {
+        while (!text.empty())
+        {
+            const size_t comma{text.find(',')};
+            std::string_view family{Trim(text.substr(0, comma))};
+            if (family.size() >= 2 && (family.front() == '"' || family.front() == '\'') && family.back() == family.front())
+            {
+                family = family.substr(1, family.size() - 2);
+            }
+
+            if (!family.empty())
+            {
+                families.push_back(family);
+            }
+
+            if (comma == std::string_view::npos)
+            {
+                break;
+            }
+
+            text = text.substr(comma + 1);
+        }
+    }
+}
+
+namespace Babylon::Polyfills::Internal
+{
+    bool ParseFontShorthand(std::string_view font, FontShorthand& result)
+    {
+        result.Size = DEFAULT_FONT_SIZE;
+        result.Families.clear();
+
+        // Style, variant, weight and stretch keywords come before the size, and the families after it.
+        std::string_view remaining{Trim(font)};
+        std::string_view lastKeyword{};
+        while (!remaining.empty())
+        {
+            const std::string_view token{NextToken(remaining)};
+            const size_t slash{token.find('/')};
+            if (ParseFontSize(token.substr(0, slash), result.Size))
+            {
+                // The line height can also be separated from the size by spaces, as in "24px / 1.5".
+                if (slash == std::string_view::npos && !remaining.empty() && remaining.front() == '/')
+                {
+                    remaining = TrimStart(remaining.substr(1));
+                    NextToken(remaining);
+                }
+
+                ParseFamilies(remaining, result.Families);
+                return !result.Families.empty();
+            }
+
+            lastKeyword = token;
+        }
+
+        // Without a size, the last word is taken as the family, as in "bold Arial".
+        if (!lastKeyword.empty())
+        {
+            result.Families.push_back(lastKeyword);
+        }
+
+        return !result.Families.empty();
+    }
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+namespace Babylon::Polyfills::Internal
+{
+    // The parts of a CSS font shorthand, such as "italic bold 24px/1.5 'Segoe UI', sans-serif", that canvas text uses.
+    struct FontShorthand
+    {
+        // Font size in pixels.
+        float Size{16.f};
+
+        // Font families in order of preference, without quotes. They point into the parsed string.
+        std::vector<std::string_view> Families{};
+    };
+
+    // Returns false when no font family can be found in the string.
+    bool ParseFontShorthand(std::string_view font, FontShorthand& result);
+}
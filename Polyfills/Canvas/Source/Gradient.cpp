@@ -0,0 +1,303 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "Canvas.h"
+#include "Gradient.h"
+#include "Colors.h"
+
+namespace Babylon::Polyfills::Internal
+{
+    namespace
+    {
+        constexpr auto JS_GRADIENT_CONSTRUCTOR_NAME = "CanvasGradient";
+
+        // Width of linear ramps, and width and height of radial ramps, which span both circles.
+        constexpr int LINEAR_RAMP_SIZE = 256;
+        constexpr int RADIAL_RAMP_SIZE = 128;
+
+        // Ramp images kept per context. Gradients whose stops change every frame would otherwise add an image per frame.
+        constexpr size_t MAX_GRADIENT_IMAGES = 64;
+
+        uint8_t ToByte(float value)
+        {
+            return static_cast<uint8_t>(std::clamp(value, 0.f, 1.f) * 255.f + 0.5f);
+        }
+
+        // Start circle of a radial gradient, and the box spanning both circles, in units of the end radius around the
+        // end centre, so that gradients differing only by a translation or a scale share their ramp.
+        struct RadialRamp
+        {
+            float StartX, StartY, StartRadius;
+            float MinX, MinY, MaxX, MaxY;
+        };
+
+        RadialRamp GetRadialRamp(float x0, float y0, float r0, float x1, float y1, float r1)
+        {
+            const float startX{(x0 - x1) / r1};
+            const float startY{(y0 - y1) / r1};
+            const float startRadius{r0 / r1};
+            return {startX, startY, startRadius,
+                std::min(startX - startRadius, -1.f), std::min(startY - startRadius, -1.f),
+                std::max(startX + startRadius, 1.f), std::max(startY + startRadius, 1.f)};
+        }
+
+        // Largest t for which the point is on the circle interpolated between the start circle and the unit end
+        // circle with a radius that isn't negative, or nothing when there is none and the point isn't painted.
+        std::optional<float> GetRadialOffset(const RadialRamp& ramp, float x, float y)
+        {
+            const float px{x - ramp.StartX};
+            const float py{y - ramp.StartY};
+            const float cx{-ramp.StartX};
+            const float cy{-ramp.StartY};
+            const float dr{1.f - ramp.StartRadius};
+
+            // |p - t * c| = r0 + t * dr, as a * t^2 - 2 * b * t + c = 0.
+            const float a{cx * cx + cy * cy - dr * dr};
+            const float b{px * cx + py * cy + ramp.StartRadius * dr};
+            const float c{px * px + py * py - ramp.StartRadius * ramp.StartRadius};
+            const auto valid{[&](float t) { return ramp.StartRadius + t * dr >= 0.f; }};
+
+            if (std::abs(a) < 1e-6f)
+            {
+                if (b == 0.f)
+                {
+                    return {};
+                }
+
+                const float t{c / (2.f * b)};
+                return valid(t) ? std::optional<float>{t} : std::nullopt;
+            }
+
+            const float discriminant{b * b - a * c};
+            if (discriminant < 0.f)
+            {
+                return {};
+            }
+
+            const float root{std::sqrt(discriminant)};
+            const float t0{(b + root) / a};
+            const float t1{(b - root) / a};
+            const float larger{std::max(t0, t1)};
+            const float smaller{std::min(t0, t1)};
+            if (valid(larger))
+            {
+                return larger;
+            }
+
+            return valid(smaller) ? std::optional<float>{smaller} : std::nullopt;
+        }
+    }
+
+    std::optional<int> GradientImageCache::Find(const std::vector<float>& key)
+    {
+        const auto it{m_index.find(key)};
+        if (it == m_index.end())
+        {
+            return {};
+        }
+
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        return it->second->second;
+    }
+
+    void GradientImageCache::Add(std::vector<float> key, int image)
+    {
+        // Images are only added after Find missed, so the key is new.
+        m_entries.emplace_front(key, image);
+        m_index.emplace(std::move(key), m_entries.begin());
+    }
+
+    void GradientImageCache::Flushed(NVGcontext* nvg)
+    {
+        while (m_entries.size() > MAX_GRADIENT_IMAGES)
+        {
+            nvgDeleteImage(nvg, m_entries.back().second);
+            m_index.erase(m_entries.back().first);
+            m_entries.pop_back();
+        }
+    }
+
+    void GradientImageCache::Clear(NVGcontext* nvg)
+    {
+        for (const auto& [key, image] : m_entries)
+        {
+            nvgDeleteImage(nvg, image);
+        }
+
+        m_entries.clear();
+        m_index.clear();
+    }
+
+    void CanvasGradient::Initialize(Napi::Env env)
+    {
+        Napi::HandleScope scope{env};
+
+        Napi::Function func = DefineClass(
+            env,
+            JS_GRADIENT_CONSTRUCTOR_NAME,
+            {
+                InstanceMethod("addColorStop", &CanvasGradient::AddColorStop),
+            });
+        JsRuntime::NativeObject::GetFromJavaScript(env).Set(JS_GRADIENT_CONSTRUCTOR_NAME, func);
+    }
+
+    Napi::Value CanvasGradient::CreateLinear(Napi::Env env, float x0, float y0, float x1, float y1)
+    {
+        auto func = JsRuntime::NativeObject::GetFromJavaScript(env).Get(JS_GRADIENT_CONSTRUCTOR_NAME).As<Napi::Function>();
+        return func.New({Napi::Value::From(env, false), Napi::Value::From(env, x0), Napi::Value::From(env, y0), Napi::Value::From(env, 0.f), Napi::Value::From(env, x1), Napi::Value::From(env, y1), Napi::Value::From(env, 0.f)});
+    }
+
+    Napi::Value CanvasGradient::CreateRadial(Napi::Env env, float x0, float y0, float r0, float x1, float y1, float r1)
+    {
+        auto func = JsRuntime::NativeObject::GetFromJavaScript(env).Get(JS_GRADIENT_CONSTRUCTOR_NAME).As<Napi::Function>();
+        return func.New({Napi::Value::From(env, true), Napi::Value::From(env, x0), Napi::Value::From(env, y0), Napi::Value::From(env, r0), Napi::Value::From(env, x1), Napi::Value::From(env, y1), Napi::Value::From(env, r1)});
+    }
+
+    CanvasGradient* CanvasGradient::TryUnwrap(const Napi::Value& value)
+    {
+        auto func = JsRuntime::NativeObject::GetFromJavaScript(value.Env()).Get(JS_GRADIENT_CONSTRUCTOR_NAME).As<Napi::Function>();
+        if (!value.IsObject() || !value.As<Napi::Object>().InstanceOf(func))
+        {
+            return nullptr;
+        }
+
+        return Unwrap(value.As<Napi::Object>());
+    }
+
+    CanvasGradient::CanvasGradient(const Napi::CallbackInfo& info)
+        : Napi::ObjectWrap<CanvasGradient>{info}
+        , m_radial{info[0].ToBoolean()}
+        , m_x0{info[1].ToNumber().FloatValue()}
+        , m_y0{info[2].ToNumber().FloatValue()}
+        , m_r0{info[3].ToNumber().FloatValue()}
+        , m_x1{info[4].ToNumber().FloatValue()}
+        , m_y1{info[5].ToNumber().FloatValue()}
+        , m_r1{info[6].ToNumber().FloatValue()}
+    {
+        if (m_r0 < 0.f || m_r1 < 0.f)
+        {
+            throw Napi::Error::New(info.Env(), "IndexSizeError: negative radius");
+        }
+    }
+
+    void CanvasGradient::AddColorStop(const Napi::CallbackInfo& info)
+    {
+        const float offset{info[0].As<Napi::Number>().FloatValue()};
+        if (!(offset >= 0.f && offset <= 1.f))
+        {
+            throw Napi::Error::New(info.Env(), "IndexSizeError: color stop offset must be between 0 and 1");
+        }
+
+        const NVGcolor color{StringToColor(info.Env(), info[1].As<Napi::String>().Utf8Value())};
+
+        // Stops with the same offset are kept in the order they were added.
+        const auto it{std::upper_bound(m_stops.begin(), m_stops.end(), offset, [](float value, const ColorStop& stop) { return value < stop.Offset; })};
+        m_stops.insert(it, {offset, color});
+    }
+
+    NVGcolor CanvasGradient::GetColor(float offset) const
+    {
+        if (offset <= m_stops.front().Offset)
+        {
+            return m_stops.front().Color;
+        }
+
+        for (size_t i = 1; i < m_stops.size(); ++i)
+        {
+            const auto& next{m_stops[i]};
+            if (offset < next.Offset)
+            {
+                const auto& previous{m_stops[i - 1]};
+                return nvgLerpRGBA(previous.Color, next.Color, (offset - previous.Offset) / (next.Offset - previous.Offset));
+            }
+        }
+
+        return m_stops.back().Color;
+    }
+
+    int CanvasGradient::GetRampImage(NVGcontext* nvg, GradientImageCache& images) const
+    {
+        const RadialRamp ramp{m_radial ? GetRadialRamp(m_x0, m_y0, m_r0, m_x1, m_y1, m_r1) : RadialRamp{}};
+
+        std::vector<float> key{m_radial ? 1.f : 0.f, ramp.StartX, ramp.StartY, ramp.StartRadius};
+        key.reserve(4 + m_stops.size() * 5);
+        for (const auto& stop : m_stops)
+        {
+            key.insert(key.end(), {stop.Offset, stop.Color.r, stop.Color.g, stop.Color.b, stop.Color.a});
+        }
+
+        if (const auto image{images.Find(key)})
+        {
+            return *image;
+        }
+
+        const int width{m_radial ? RADIAL_RAMP_SIZE : LINEAR_RAMP_SIZE};
+        const int height{m_radial ? RADIAL_RAMP_SIZE : 1};
+        std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 4);
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                std::optional<float> offset{(x + 0.5f) / width};
+                if (m_radial)
+                {
+                    const float px{ramp.MinX + (x + 0.5f) / width * (ramp.MaxX - ramp.MinX)};
+                    const float py{ramp.MinY + (y + 0.5f) / height * (ramp.MaxY - ramp.MinY)};
+                    offset = GetRadialOffset(ramp, px, py);
+                }
+
+                const NVGcolor color{offset ? GetColor(*offset) : TRANSPARENT_BLACK};
+                uint8_t* pixel{&pixels[(static_cast<size_t>(y) * width + x) * 4]};
+                pixel[0] = ToByte(color.r);
+                pixel[1] = ToByte(color.g);
+                pixel[2] = ToByte(color.b);
+                pixel[3] = ToByte(color.a);
+            }
+        }
+
+        // Images without repeat flags are clamped, which extends the end colors past the gradient. Past the box spanning
+        // both circles, this is exact only when one circle contains the other.
+        const int image{nvgCreateImageRGBA(nvg, width, height, 0, pixels.data())};
+        images.Add(std::move(key), image);
+        return image;
+    }
+
+    NVGpaint CanvasGradient::CreatePaint(NVGcontext* nvg, GradientImageCache& images) const
+    {
+        // Gradients without stops, and degenerate gradients, paint nothing.
+        const bool degenerate{m_radial ? (m_x0 == m_x1 && m_y0 == m_y1 && m_r0 == m_r1) || m_r1 == 0.f : (m_x0 == m_x1 && m_y0 == m_y1)};
+        if (m_stops.empty() || degenerate)
+        {
+            return nvgLinearGradient(nvg, 0.f, 0.f, 1.f, 0.f, TRANSPARENT_BLACK, TRANSPARENT_BLACK);
+        }
+
+        // The fill shader only computes radial gradients with a single centre.
+        if (m_stops.size() <= 2 && (!m_radial || (m_x0 == m_x1 && m_y0 == m_y1)))
+        {
+            const auto& first{m_stops.front()};
+            const auto& last{m_stops.back()};
+            if (m_radial)
+            {
+                const float inner{m_r0 + (m_r1 - m_r0) * first.Offset};
+                const float outer{m_r0 + (m_r1 - m_r0) * last.Offset};
+                return nvgRadialGradient(nvg, m_x1, m_y1, inner, outer, first.Color, last.Color);
+            }
+
+            const float dx{m_x1 - m_x0};
+            const float dy{m_y1 - m_y0};
+            return nvgLinearGradient(nvg, m_x0 + dx * first.Offset, m_y0 + dy * first.Offset, m_x0 + dx * last.Offset, m_y0 + dy * last.Offset, first.Color, last.Color);
+        }
+
+        const int image{GetRampImage(nvg, images)};
+        if (m_radial)
+        {
+            const RadialRamp ramp{GetRadialRamp(m_x0, m_y0, m_r0, m_x1, m_y1, m_r1)};
+            return nvgImagePattern(nvg, m_x1 + ramp.MinX * m_r1, m_y1 + ramp.MinY * m_r1, (ramp.MaxX - ramp.MinX) * m_r1, (ramp.MaxY - ramp.MinY) * m_r1, 0.f, image, 1.f);
+        }
+
+        const float dx{m_x1 - m_x0};
+        const float dy{m_y1 - m_y0};
+        return nvgImagePattern(nvg, m_x0, m_y0, std::sqrt(dx * dx + dy * dy), 1.f, std::atan2(dy, dx), image, 1.f);
+    }
+}
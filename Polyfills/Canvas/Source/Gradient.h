@@ -0,0 +1,77 @@
+#pragma once
+
+#include <Babylon/Polyfills/Canvas.h>
+
+#include <list>
+#include <map>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+
+#include "nanovg/nanovg.h"
+
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
+
+namespace Babylon::Polyfills::Internal
+{
+    // Least recently used ramp images of gradients with more than two stops, keyed by their shape and stops. Each nanovg
+    // context has its own. Past a few images, the least recently used ones are deleted when the context flushes, since
+    // no draw recorded before the flush can use them anymore.
+    class GradientImageCache
+    {
+    public:
+        std::optional<int> Find(const std::vector<float>& key);
+        void Add(std::vector<float> key, int image);
+
+        // Called once the draws recorded so far have been given to the graphics device.
+        void Flushed(NVGcontext* nvg);
+        void Clear(NVGcontext* nvg);
+
+    private:
+        using Entries = std::list<std::pair<std::vector<float>, int>>;
+
+        Entries m_entries{};
+        std::map<std::vector<float>, Entries::iterator> m_index{};
+    };
+
+    class CanvasGradient final : public Napi::ObjectWrap<CanvasGradient>
+    {
+    public:
+        static void Initialize(Napi::Env env);
+        static Napi::Value CreateLinear(Napi::Env env, float x0, float y0, float x1, float y1);
+        static Napi::Value CreateRadial(Napi::Env env, float x0, float y0, float r0, float x1, float y1, float r1);
+
+        // Returns nullptr when the value is not a CanvasGradient.
+        static CanvasGradient* TryUnwrap(const Napi::Value& value);
+
+        explicit CanvasGradient(const Napi::CallbackInfo& info);
+
+        // Paint in the current space of the context. Linear and concentric radial gradients with up to two stops are
+        // computed by the fill shader, the others sample a ramp image shared by all the gradients of the context with
+        // the same shape and stops.
+        NVGpaint CreatePaint(NVGcontext* nvg, GradientImageCache& images) const;
+
+    private:
+        struct ColorStop
+        {
+            float Offset;
+            NVGcolor Color;
+        };
+
+        void AddColorStop(const Napi::CallbackInfo& info);
+        NVGcolor GetColor(float offset) const;
+        int GetRampImage(NVGcontext* nvg, GradientImageCache& images) const;
+
+        bool m_radial{};
+        float m_x0{}, m_y0{}, m_r0{};
+        float m_x1{}, m_y1{}, m_r1{};
+        std::vector<ColorStop> m_stops{};
+    };
+}
@@ -8,10 +8,13 @@
 #include <assert.h>
 #include <bimg/bimg.h>
 #include <bimg/decode.h>
-#include "nanovg.h"
 #include <cassert>
 #include <napi/napi_pointer.h>
 #include <basen.hpp>
+#include <arcana/threading/task_schedulers.h>
+#include <stb/stb_image_resize.h>
+#include <algorithm>
+#include <cmath>
 
 namespace Babylon::Polyfills::Internal
 {
@@ -30,8 +33,11 @@ namespace Babylon::Polyfills::Internal
                 InstanceAccessor("naturalWidth", &NativeCanvasImage::GetNaturalWidth, nullptr),
                 InstanceAccessor("naturalHeight", &NativeCanvasImage::GetNaturalHeight, nullptr),
                 InstanceAccessor("src", &NativeCanvasImage::GetSrc, &NativeCanvasImage::SetSrc),
+                InstanceAccessor("decodeWidth", &NativeCanvasImage::GetDecodeWidth, &NativeCanvasImage::SetDecodeWidth),
+                InstanceAccessor("decodeHeight", &NativeCanvasImage::GetDecodeHeight, &NativeCanvasImage::SetDecodeHeight),
                 InstanceAccessor("onload", nullptr, &NativeCanvasImage::SetOnload),
                 InstanceAccessor("onerror", nullptr, &NativeCanvasImage::SetOnerror),
+                InstanceMethod("decode", &NativeCanvasImage::Decode),
                 // TODO: This should be set directly on the JS Object rather than via an instanceAccessor see: https://github.com/BabylonJS/BabylonNative/issues/1030
                 InstanceAccessor("_imageContainer", &NativeCanvasImage::GetImageContainer, nullptr),
             });
@@ -41,6 +47,7 @@ namespace Babylon::Polyfills::Internal
 
     NativeCanvasImage::NativeCanvasImage(const Napi::CallbackInfo& info)
         : Napi::ObjectWrap<NativeCanvasImage>{info}
+        , m_graphicsContext{Graphics::DeviceContext::GetFromJavaScript(info.Env())}
         , m_runtimeScheduler{JsRuntime::GetFromJavaScript(info.Env())}
         , m_cancellationSource{std::make_shared<arcana::cancellation_source>()}
     {
@@ -53,11 +60,8 @@ namespace Babylon::Polyfills::Internal
 
     void NativeCanvasImage::Dispose()
     {
-        if (m_imageContainer)
-        {
-            bimg::imageFree(m_imageContainer);
-            m_imageContainer = nullptr;
-        }
+        m_imageContainer.reset();
+        m_texture.reset();
         m_cancellationSource->cancel();
     }
 
@@ -86,11 +90,31 @@ namespace Babylon::Polyfills::Internal
         return Napi::Value::From(Env(), m_src);
     }
 
+    Napi::Value NativeCanvasImage::GetDecodeWidth(const Napi::CallbackInfo&)
+    {
+        return Napi::Value::From(Env(), m_decodeWidth);
+    }
+
+    Napi::Value NativeCanvasImage::GetDecodeHeight(const Napi::CallbackInfo&)
+    {
+        return Napi::Value::From(Env(), m_decodeHeight);
+    }
+
+    void NativeCanvasImage::SetDecodeWidth(const Napi::CallbackInfo&, const Napi::Value& value)
+    {
+        m_decodeWidth = value.As<Napi::Number>().Uint32Value();
+    }
+
+    void NativeCanvasImage::SetDecodeHeight(const Napi::CallbackInfo&, const Napi::Value& value)
+    {
+        m_decodeHeight = value.As<Napi::Number>().Uint32Value();
+    }
+
     Napi::Value NativeCanvasImage::GetImageContainer(const Napi::CallbackInfo&)
     {
         if (m_imageContainer != nullptr)
         {
-            return Napi::Pointer<bimg::ImageContainer>::Create(Env(), m_imageContainer);
+            return Napi::Pointer<bimg::ImageContainer>::Create(Env(), m_imageContainer.get());
         }
         else
         {
@@ -98,72 +122,137 @@ namespace Babylon::Polyfills::Internal
         }
     }
 
-    bool NativeCanvasImage::SetBuffer(gsl::span<const std::byte> buffer)
+    NativeCanvasImage::DecodedImage NativeCanvasImage::DecodeImage(gsl::span<const std::byte> buffer, uint32_t decodeWidth, uint32_t decodeHeight, const char* errorMessage)
     {
-        m_imageContainer = bimg::imageParse(&Graphics::DeviceContext::GetDefaultAllocator(), buffer.data(), static_cast<uint32_t>(buffer.size_bytes()), bimg::TextureFormat::RGBA8);
+        auto* allocator{&Graphics::DeviceContext::GetDefaultAllocator()};
+        bimg::ImageContainer* image{bimg::imageParse(allocator, buffer.data(), static_cast<uint32_t>(buffer.size_bytes()), bimg::TextureFormat::RGBA8)};
+        if (image == nullptr)
+        {
+            throw std::runtime_error{errorMessage};
+        }
 
-        if (m_imageContainer == nullptr)
+        DecodedImage decoded{{image, bimg::imageFree}, image->m_width, image->m_height};
+
+        // Downscale to the smallest size still covering the requested one, so that thumbnails of large images
+        // don't keep the full size pixels around or upload them.
+        const float scale{std::max(decodeWidth / static_cast<float>(decoded.Width), decodeHeight / static_cast<float>(decoded.Height))};
+        if (scale > 0.f && scale < 1.f)
+        {
+            const auto width{static_cast<uint16_t>(std::max(1.f, std::ceil(decoded.Width * scale)))};
+            const auto height{static_cast<uint16_t>(std::max(1.f, std::ceil(decoded.Height * scale)))};
+            std::shared_ptr<bimg::ImageContainer> resized{bimg::imageAlloc(allocator, bimg::TextureFormat::RGBA8, width, height, 1, 1, false, false), bimg::imageFree};
+            stbir_resize_uint8(static_cast<const unsigned char*>(image->m_data), image->m_width, image->m_height, 0,
+                static_cast<unsigned char*>(resized->m_data), width, height, 0, 4);
+            decoded.Container = std::move(resized);
+        }
+
+        return decoded;
+    }
+
+    void NativeCanvasImage::OnDecoded(uint32_t loadId, const DecodeResult& result)
+    {
+        if (loadId != m_loadId)
         {
-            return false;
+            return;
         }
 
-        m_width = m_imageContainer->m_width;
-        m_height = m_imageContainer->m_height;
+        m_loading = false;
+        auto deferreds{std::move(m_decodeDeferreds)};
+        m_decodeDeferreds.clear();
+
+        if (result.has_error())
+        {
+            const auto error{Napi::Error::New(Env(), result.error())};
+            for (auto& deferred : deferreds)
+            {
+                deferred.Reject(error.Value());
+            }
+
+            // Errors are already reported to the decode promises, if any.
+            if (!m_onerrorHandlerRef.IsEmpty() || deferreds.empty())
+            {
+                HandleLoadImageError(error);
+            }
+            return;
+        }
+
+        m_imageContainer = result.value().Container;
+        m_width = result.value().Width;
+        m_height = result.value().Height;
+
+        // Contexts notice that the texture changed the next time they draw the image.
+        m_texture.reset();
 
         if (!m_onloadHandlerRef.IsEmpty())
         {
             m_onloadHandlerRef.Call({});
         }
-        return true;
+
+        for (auto& deferred : deferreds)
+        {
+            deferred.Resolve(Env().Undefined());
+        }
     }
 
-    void NativeCanvasImage::SetSrc(const Napi::CallbackInfo& info, const Napi::Value& value)
+    void NativeCanvasImage::SetSrc(const Napi::CallbackInfo&, const Napi::Value& value)
     {
-        auto text{value.As<Napi::String>().Utf8Value()};
+        m_src = value.As<Napi::String>().Utf8Value();
+        m_loading = true;
+
+        // Decoding happens on the thread pool, the image is only updated on the JavaScript thread once it's done.
+        const uint32_t loadId{++m_loadId};
+        const uint32_t decodeWidth{m_decodeWidth};
+        const uint32_t decodeHeight{m_decodeHeight};
+        const auto onDecoded{[this, loadId, cancellationSource{m_cancellationSource}](const DecodeResult& result) {
+            OnDecoded(loadId, result);
+        }};
 
         // try with base64
         static const std::string base64{"base64,"};
-        const auto pos = text.find(base64);
+        const auto pos = m_src.find(base64);
         if (pos != std::string::npos)
         {
-            arcana::make_task(m_runtimeScheduler, *m_cancellationSource, [env{info.Env()}, this, text{std::move(text)}, pos]() {
+            arcana::make_task(arcana::threadpool_scheduler, *m_cancellationSource, [text{m_src}, pos, decodeWidth, decodeHeight]() {
                 std::vector<uint8_t> base64Buffer;
                 bn::decode_b64(text.begin() + pos + base64.length(), text.end(), std::back_inserter(base64Buffer));
                 gsl::span<const std::byte> buffer = {reinterpret_cast<std::byte*>(base64Buffer.data()), base64Buffer.size()};
-
-                if (!SetBuffer(buffer))
-                {
-                    HandleLoadImageError(Napi::Error::New(env, "Unable to decode image with provided base64 source."));
-                }
-            });
+                return DecodeImage(buffer, decodeWidth, decodeHeight, "Unable to decode image with provided base64 source.");
+            }).then(m_runtimeScheduler, *m_cancellationSource, onDecoded);
             return;
         }
 
         // try with URL
         UrlLib::UrlRequest request{};
-        request.Open(UrlLib::UrlMethod::Get, text);
+        request.Open(UrlLib::UrlMethod::Get, m_src);
         request.ResponseType(UrlLib::UrlResponseType::Buffer);
-        request.SendAsync().then(m_runtimeScheduler, *m_cancellationSource, [env{info.Env()}, this, cancellationSource{m_cancellationSource}, request{std::move(request)}, text](arcana::expected<void, std::exception_ptr> result) {
-            if (result.has_error())
-            {
-                HandleLoadImageError(Napi::Error::New(env, result.error()));
-                return;
-            }
-
-            Dispose();
-
+        request.SendAsync().then(arcana::threadpool_scheduler, *m_cancellationSource, [request{std::move(request)}, decodeWidth, decodeHeight]() {
             auto buffer{request.ResponseBuffer()};
             if (buffer.data() == nullptr || buffer.size_bytes() == 0)
             {
-                HandleLoadImageError(Napi::Error::New(env, "Image with provided source returned empty response or invalid base64."));
-                return;
+                throw std::runtime_error{"Image with provided source returned empty response or invalid base64."};
             }
 
-            if (!SetBuffer(buffer))
-            {
-                HandleLoadImageError(Napi::Error::New(env, "Unable to decode image with provided source URL."));
-            }
-        });
+            return DecodeImage(buffer, decodeWidth, decodeHeight, "Unable to decode image with provided source URL.");
+        }).then(m_runtimeScheduler, *m_cancellationSource, onDecoded);
+    }
+
+    Napi::Value NativeCanvasImage::Decode(const Napi::CallbackInfo& info)
+    {
+        auto deferred{Napi::Promise::Deferred::New(info.Env())};
+        if (m_loading)
+        {
+            m_decodeDeferreds.push_back(deferred);
+        }
+        else if (m_imageContainer != nullptr)
+        {
+            deferred.Resolve(info.Env().Undefined());
+        }
+        else
+        {
+            deferred.Reject(Napi::Error::New(info.Env(), "EncodingError: the image has no decoded source").Value());
+        }
+
+        return deferred.Promise();
     }
 
     void NativeCanvasImage::SetOnload(const Napi::CallbackInfo&, const Napi::Value& value)
@@ -178,9 +267,21 @@ namespace Babylon::Polyfills::Internal
         m_onerrorHandlerRef = Napi::Persistent(eventHandler);
     }
 
-    int NativeCanvasImage::CreateNVGImageForContext(NVGcontext* nvgContext) const
+    std::shared_ptr<Graphics::Texture> NativeCanvasImage::GetTexture()
     {
-        return nvgCreateImageRGBA(nvgContext, m_width, m_height, 0, static_cast<const unsigned char*>(m_imageContainer->m_data));
+        auto texture{m_texture.lock()};
+        if (!texture && m_imageContainer != nullptr)
+        {
+            // Downscaled images are drawn at their natural size, nanovg patterns sample the texture in normalized coordinates.
+            const auto width{static_cast<uint16_t>(m_imageContainer->m_width)};
+            const auto height{static_cast<uint16_t>(m_imageContainer->m_height)};
+            texture = std::make_shared<Graphics::Texture>(m_graphicsContext);
+            texture->Create2D(width, height, false, 1, bgfx::TextureFormat::RGBA8, BGFX_SAMPLER_U_CLAMP | BGFX_SAMPLER_V_CLAMP);
+            texture->Update2D(0, 0, 0, 0, width, height, bgfx::copy(m_imageContainer->m_data, static_cast<uint32_t>(width) * height * 4));
+            m_texture = texture;
+        }
+
+        return texture;
     }
 
     void NativeCanvasImage::HandleLoadImageError(const Napi::Error& error)
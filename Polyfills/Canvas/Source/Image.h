@@ -3,12 +3,15 @@
 #include <Babylon/Polyfills/Canvas.h>
 #include <Babylon/Graphics/DeviceContext.h>
 #include <Babylon/Graphics/FrameBuffer.h>
+#include <Babylon/Graphics/Texture.h>
 #include <UrlLib/UrlLib.h>
 #include <Babylon/JsRuntimeScheduler.h>
 #include <bx/allocator.h>
 #include <bimg/bimg.h>
+#include <arcana/threading/task.h>
 
-struct NVGcontext;
+#include <memory>
+#include <vector>
 
 namespace Babylon::Polyfills::Internal
 {
@@ -20,23 +23,45 @@ namespace Babylon::Polyfills::Internal
         explicit NativeCanvasImage(const Napi::CallbackInfo& info);
         virtual ~NativeCanvasImage();
 
-        int CreateNVGImageForContext(NVGcontext* nvgContext) const;
+        // The texture of the image is shared by all the contexts that draw it. It is created on first use, and released
+        // once the last context drawing it lets go of it. Returns nullptr until the image is loaded.
+        std::shared_ptr<Graphics::Texture> GetTexture();
 
+        // The natural size of the image. The decoded pixels can be smaller when a decode size was requested.
         uint32_t GetWidth() const { return m_width; }
         uint32_t GetHeight() const { return m_height; }
 
+        // Expires once the image is destroyed, so that contexts can tell the images they drew that are gone.
+        std::weak_ptr<const void> GetLifetime() const { return m_lifetime; }
+
     private:
+        struct DecodedImage
+        {
+            std::shared_ptr<bimg::ImageContainer> Container;
+            uint32_t Width;
+            uint32_t Height;
+        };
+
+        using DecodeResult = arcana::expected<DecodedImage, std::exception_ptr>;
+
+        static DecodedImage DecodeImage(gsl::span<const std::byte> buffer, uint32_t decodeWidth, uint32_t decodeHeight, const char* errorMessage);
+
         Napi::Value GetWidth(const Napi::CallbackInfo&);
         Napi::Value GetHeight(const Napi::CallbackInfo&);
         Napi::Value GetNaturalWidth(const Napi::CallbackInfo&);
         Napi::Value GetNaturalHeight(const Napi::CallbackInfo&);
         Napi::Value GetSrc(const Napi::CallbackInfo&);
+        Napi::Value GetDecodeWidth(const Napi::CallbackInfo&);
+        Napi::Value GetDecodeHeight(const Napi::CallbackInfo&);
         Napi::Value GetImageContainer(const Napi::CallbackInfo&);
         void SetSrc(const Napi::CallbackInfo&, const Napi::Value&);
+        void SetDecodeWidth(const Napi::CallbackInfo&, const Napi::Value&);
+        void SetDecodeHeight(const Napi::CallbackInfo&, const Napi::Value&);
         void SetOnload(const Napi::CallbackInfo&, const Napi::Value&);
         void SetOnerror(const Napi::CallbackInfo&, const Napi::Value&);
+        Napi::Value Decode(const Napi::CallbackInfo&);
         void HandleLoadImageError(const Napi::Error& error);
-        bool SetBuffer(gsl::span<const std::byte> buffer);
+        void OnDecoded(uint32_t loadId, const DecodeResult& result);
         void Dispose();
 
         uint32_t m_width{1};
@@ -44,10 +69,23 @@ namespace Babylon::Polyfills::Internal
 
         std::string m_src{};
 
+        // Size the image is going to be drawn at. Larger images are downscaled when decoded, zero means no limit.
+        uint32_t m_decodeWidth{};
+        uint32_t m_decodeHeight{};
+
+        // Incremented for each new source, so that the results of older loads are dropped.
+        uint32_t m_loadId{};
+        bool m_loading{};
+        std::vector<Napi::Promise::Deferred> m_decodeDeferreds{};
+
+        Graphics::DeviceContext& m_graphicsContext;
+        std::weak_ptr<Graphics::Texture> m_texture{};
+
         JsRuntimeScheduler m_runtimeScheduler;
         Napi::FunctionReference m_onloadHandlerRef;
         Napi::FunctionReference m_onerrorHandlerRef;
         std::shared_ptr<arcana::cancellation_source> m_cancellationSource{};
-        bimg::ImageContainer* m_imageContainer{};
+        std::shared_ptr<bimg::ImageContainer> m_imageContainer{};
+        std::shared_ptr<const void> m_lifetime{std::make_shared<bool>()};
     };
 }
@@ -1,27 +1,14 @@
-#include <bgfx/bgfx.h>
-#include <map>
 #include "Canvas.h"
-#include "Context.h"
 #include "ImageData.h"
 
-#ifdef __GNUC__
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wpedantic"
-#endif
-
-#include "nanovg/nanovg.h"
-
-#ifdef __GNUC__
-#pragma GCC diagnostic pop
-#endif
-
 namespace Babylon::Polyfills::Internal
 {
     static constexpr auto JS_IMAGEDATA_CONSTRUCTOR_NAME = "ImageData";
 
-    Napi::Value ImageData::CreateInstance(Napi::Env env, Context* context, uint32_t width, uint32_t height)
+    void ImageData::Initialize(Napi::Env env)
     {
         Napi::HandleScope scope{env};
+
         Napi::Function func = DefineClass(
             env,
             JS_IMAGEDATA_CONSTRUCTOR_NAME,
@@ -30,17 +17,28 @@ namespace Babylon::Polyfills::Internal
                 InstanceAccessor("height", &ImageData::GetHeight, nullptr),
                 InstanceAccessor("data", &ImageData::GetData, nullptr),
             });
-        return func.New({Napi::External<Context>::New(env, context), Napi::Value::From(env, width), Napi::Value::From(env, height)});
+        JsRuntime::NativeObject::GetFromJavaScript(env).Set(JS_IMAGEDATA_CONSTRUCTOR_NAME, func);
+    }
+
+    Napi::Value ImageData::CreateInstance(Napi::Env env, uint32_t width, uint32_t height)
+    {
+        auto func = JsRuntime::NativeObject::GetFromJavaScript(env).Get(JS_IMAGEDATA_CONSTRUCTOR_NAME).As<Napi::Function>();
+        return func.New({Napi::Value::From(env, width), Napi::Value::From(env, height)});
     }
 
     ImageData::ImageData(const Napi::CallbackInfo& info)
         : Napi::ObjectWrap<ImageData>{info}
+        , m_width{info[0].As<Napi::Number>().Uint32Value()}
+        , m_height{info[1].As<Napi::Number>().Uint32Value()}
     {
-        auto context{info[0].As<Napi::External<Context>>().Data()};
-        auto width{info[1].As<Napi::Number>().Uint32Value()};
-        auto height{info[1].As<Napi::Number>().Uint32Value()};
-        m_width = width;
-        m_height = height;
+        if (m_width == 0 || m_height == 0)
+        {
+            throw Napi::Error::New(info.Env(), "IndexSizeError: image data width and height must not be zero");
+        }
+
+        // Typed arrays are zero initialized, which is transparent black.
+        const size_t size{static_cast<size_t>(m_width) * m_height * 4};
+        m_data = Napi::Persistent(Napi::Uint8Array::New(info.Env(), size, napi_uint8_clamped_array));
     }
 
     Napi::Value ImageData::GetWidth(const Napi::CallbackInfo&)
@@ -53,13 +51,8 @@ namespace Babylon::Polyfills::Internal
         return Napi::Value::From(Env(), m_height);
     }
 
-    Napi::Value ImageData::GetData(const Napi::CallbackInfo& info)
+    Napi::Value ImageData::GetData(const Napi::CallbackInfo&)
     {
-        // return a well size array with 0
-        // TODO: Get datas from context/canvas
-        const auto size{m_width * m_height * 4};
-        auto data{Napi::Uint8Array::New(info.Env(), size)};
-        memset(data.Data(), 0, size);
-        return Napi::Value::From(info.Env(), data);
+        return m_data.Value();
     }
 }
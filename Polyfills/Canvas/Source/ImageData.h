@@ -7,10 +7,17 @@ namespace Babylon::Polyfills::Internal
     class ImageData final : public Napi::ObjectWrap<ImageData>
     {
     public:
-        static Napi::Value CreateInstance(Napi::Env env, Context* context, uint32_t width, uint32_t height);
+        static void Initialize(Napi::Env env);
+        static Napi::Value CreateInstance(Napi::Env env, uint32_t width, uint32_t height);
 
         explicit ImageData(const Napi::CallbackInfo& info);
 
+        uint32_t GetWidth() const { return m_width; }
+        uint32_t GetHeight() const { return m_height; }
+
+        // Unpremultiplied RGBA rows, top to bottom, as in the data array seen by JavaScript.
+        uint8_t* GetPixels() { return m_data.Value().Data(); }
+
     private:
         Napi::Value GetWidth(const Napi::CallbackInfo&);
         Napi::Value GetHeight(const Napi::CallbackInfo&);
@@ -18,5 +25,6 @@ namespace Babylon::Polyfills::Internal
 
         uint32_t m_width{};
         uint32_t m_height{};
+        Napi::Reference<Napi::Uint8Array> m_data{};
     };
-}
\ No newline at end of file
+}
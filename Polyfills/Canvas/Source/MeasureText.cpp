@@ -4,23 +4,11 @@
 #include "Context.h"
 #include "MeasureText.h"
 
-#ifdef __GNUC__
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wpedantic"
-#endif
-
-#include "nanovg/nanovg.h"
-
-#ifdef __GNUC__
-#pragma GCC diagnostic pop
-#endif
-
 namespace Babylon::Polyfills::Internal
 {
-    Napi::Value MeasureText::CreateInstance(Napi::Env env, Context* context, const std::string& text)
+    Napi::Value MeasureText::CreateInstance(Napi::Env env, const TextCache::Layout& layout)
     {
-        float bounds[4];
-        nvgTextBounds(context->GetNVGContext(), 0, 0, text.c_str(), nullptr, bounds);
+        const float* bounds{layout.Bounds};
 
         auto obj{Napi::Object::New(env)};
         obj.Set("width", Napi::Value::From(env, bounds[2] - bounds[0]));
@@ -1,11 +1,12 @@
 #pragma once
 
 #include <Babylon/Polyfills/Canvas.h>
+#include "TextCache.h"
 
 namespace Babylon::Polyfills::Internal
 {
     namespace MeasureText
     {
-        Napi::Value CreateInstance(Napi::Env env, Context* context, const std::string& text);
+        Napi::Value CreateInstance(Napi::Env env, const TextCache::Layout& layout);
     }
 }
\ No newline at end of file
@@ -0,0 +1,214 @@
+#include <algorithm>
+#include <cmath>
+
+#include "Path.h"
+
+namespace Babylon::Polyfills::Internal
+{
+    namespace
+    {
+        // nanovg's tessellation tolerance and subdivision limit for curves, in canvas pixels.
+        constexpr float TESSELLATION_TOLERANCE = 0.25f;
+        constexpr int MAX_BEZIER_LEVEL = 10;
+
+        struct PathPoint
+        {
+            float X;
+            float Y;
+        };
+
+        void FlattenBezier(std::vector<PathPoint>& points, float x1, float y1, float x2, float y2, float x3, float y3, float x4, float y4, int level)
+        {
+            const float dx{x4 - x1};
+            const float dy{y4 - y1};
+            const float d2{std::abs((x2 - x4) * dy - (y2 - y4) * dx)};
+            const float d3{std::abs((x3 - x4) * dy - (y3 - y4) * dx)};
+            if (level >= MAX_BEZIER_LEVEL || (d2 + d3) * (d2 + d3) < TESSELLATION_TOLERANCE * (dx * dx + dy * dy))
+            {
+                points.push_back({x4, y4});
+                return;
+            }
+
+            const float x12{(x1 + x2) * 0.5f}, y12{(y1 + y2) * 0.5f};
+            const float x23{(x2 + x3) * 0.5f}, y23{(y2 + y3) * 0.5f};
+            const float x34{(x3 + x4) * 0.5f}, y34{(y3 + y4) * 0.5f};
+            const float x123{(x12 + x23) * 0.5f}, y123{(y12 + y23) * 0.5f};
+            const float x234{(x23 + x34) * 0.5f}, y234{(y23 + y34) * 0.5f};
+            const float x1234{(x123 + x234) * 0.5f}, y1234{(y123 + y234) * 0.5f};
+            FlattenBezier(points, x1, y1, x12, y12, x123, y123, x1234, y1234, level + 1);
+            FlattenBezier(points, x1234, y1234, x234, y234, x34, y34, x4, y4, level + 1);
+        }
+
+        // Appends the dashes of a flattened subpath. Dashes continue across its points, so that they get joins.
+        void AppendDashedPolyline(NVGcontext* nvg, const std::vector<PathPoint>& points, bool closed, const std::vector<float>& pattern, float patternLength, float offset, float scale)
+        {
+            if (points.size() < 2)
+            {
+                return;
+            }
+
+            // Finds where in the pattern the subpath starts.
+            size_t dash{0};
+            float remaining{pattern[0] * scale};
+            float skip{std::fmod(offset, patternLength)};
+            if (skip < 0.f)
+            {
+                skip += patternLength;
+            }
+            while (skip >= remaining)
+            {
+                skip -= remaining;
+                dash = (dash + 1) % pattern.size();
+                remaining = pattern[dash] * scale;
+            }
+            remaining -= skip;
+
+            bool drawing{false};
+            const size_t segmentCount{closed ? points.size() : points.size() - 1};
+            for (size_t segment = 0; segment < segmentCount; ++segment)
+            {
+                const PathPoint& from{points[segment]};
+                const PathPoint& to{points[(segment + 1) % points.size()]};
+                const float dx{to.X - from.X};
+                const float dy{to.Y - from.Y};
+                const float length{std::sqrt(dx * dx + dy * dy)};
+
+                float position{0.f};
+                while (position < length)
+                {
+                    const float step{std::min(remaining, length - position)};
+                    if (dash % 2 == 0)
+                    {
+                        if (!drawing)
+                        {
+                            nvgMoveTo(nvg, from.X + dx * position / length, from.Y + dy * position / length);
+                            drawing = true;
+                        }
+                        nvgLineTo(nvg, from.X + dx * (position + step) / length, from.Y + dy * (position + step) / length);
+                    }
+
+                    position += step;
+                    remaining -= step;
+                    if (remaining <= 0.f)
+                    {
+                        dash = (dash + 1) % pattern.size();
+                        remaining = pattern[dash] * scale;
+                        drawing = false;
+                    }
+                }
+            }
+        }
+    }
+
+    void CanvasPath::MoveTo(const float* transform, float x, float y)
+    {
+        Command command{CommandType::MoveTo, {}};
+        nvgTransformPoint(&command.Points[0], &command.Points[1], transform, x, y);
+        m_commands.push_back(command);
+    }
+
+    void CanvasPath::LineTo(const float* transform, float x, float y)
+    {
+        Command command{CommandType::LineTo, {}};
+        nvgTransformPoint(&command.Points[0], &command.Points[1], transform, x, y);
+        m_commands.push_back(command);
+    }
+
+    void CanvasPath::BezierTo(const float* transform, float c1x, float c1y, float c2x, float c2y, float x, float y)
+    {
+        Command command{CommandType::BezierTo, {}};
+        nvgTransformPoint(&command.Points[0], &command.Points[1], transform, c1x, c1y);
+        nvgTransformPoint(&command.Points[2], &command.Points[3], transform, c2x, c2y);
+        nvgTransformPoint(&command.Points[4], &command.Points[5], transform, x, y);
+        m_commands.push_back(command);
+    }
+
+    void CanvasPath::Close()
+    {
+        m_commands.push_back({CommandType::Close, {}});
+    }
+
+    void CanvasPath::Append(NVGcontext* nvg) const
+    {
+        for (const auto& command : m_commands)
+        {
+            const float* points{command.Points};
+            switch (command.Type)
+            {
+                case CommandType::MoveTo:
+                    nvgMoveTo(nvg, points[0], points[1]);
+                    break;
+                case CommandType::LineTo:
+                    nvgLineTo(nvg, points[0], points[1]);
+                    break;
+                case CommandType::BezierTo:
+                    nvgBezierTo(nvg, points[0], points[1], points[2], points[3], points[4], points[5]);
+                    break;
+                case CommandType::Close:
+                    nvgClosePath(nvg);
+                    break;
+            }
+        }
+    }
+
+    void CanvasPath::AppendDashes(NVGcontext* nvg, const std::vector<float>& pattern, float offset, float scale) const
+    {
+        float patternLength{0.f};
+        for (const float length : pattern)
+        {
+            patternLength += length * scale;
+        }
+
+        // Dashes below the tessellation tolerance couldn't be told apart from a solid line anyway.
+        if (!(patternLength >= TESSELLATION_TOLERANCE))
+        {
+            Append(nvg);
+            return;
+        }
+
+        std::vector<PathPoint> points{};
+        PathPoint start{};
+        size_t index{0};
+        while (index < m_commands.size())
+        {
+            // A subpath ends at the next move or once it is closed. A subpath following a closed one starts where it did.
+            points.clear();
+            bool closed{false};
+            for (; index < m_commands.size() && !closed; ++index)
+            {
+                const auto& command{m_commands[index]};
+                const float* commandPoints{command.Points};
+                if (command.Type == CommandType::MoveTo)
+                {
+                    if (!points.empty())
+                    {
+                        break;
+                    }
+                    start = {commandPoints[0], commandPoints[1]};
+                    points.push_back(start);
+                    continue;
+                }
+
+                if (points.empty())
+                {
+                    points.push_back(start);
+                }
+
+                switch (command.Type)
+                {
+                    case CommandType::LineTo:
+                        points.push_back({commandPoints[0], commandPoints[1]});
+                        break;
+                    case CommandType::BezierTo:
+                        FlattenBezier(points, points.back().X, points.back().Y, commandPoints[0], commandPoints[1], commandPoints[2], commandPoints[3], commandPoints[4], commandPoints[5], 0);
+                        break;
+                    default:
+                        closed = true;
+                        break;
+                }
+            }
+
+            AppendDashedPolyline(nvg, points, closed, pattern, patternLength, offset * scale, scale);
+        }
+    }
+}
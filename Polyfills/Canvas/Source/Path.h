@@ -0,0 +1,56 @@
+#pragma once
+
+#include <vector>
+
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+
+#include "nanovg/nanovg.h"
+
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
+
+namespace Babylon::Polyfills::Internal
+{
+    // A path in canvas pixels, recorded as it is given to nanovg. nanovg can neither dash strokes nor hand its path back,
+    // so dashes are cut from the recorded copy, which can also be given to nanovg again once a stroke replaced its path.
+    class CanvasPath
+    {
+    public:
+        void Clear() { m_commands.clear(); }
+        bool IsEmpty() const { return m_commands.empty(); }
+
+        // Points are transformed to canvas pixels by the given nanovg transform, as nanovg does with the points of its path.
+        void MoveTo(const float* transform, float x, float y);
+        void LineTo(const float* transform, float x, float y);
+        void BezierTo(const float* transform, float c1x, float c1y, float c2x, float c2y, float x, float y);
+        void Close();
+
+        // Appends the path to the current nanovg path, which is expected to have the identity transform.
+        void Append(NVGcontext* nvg) const;
+
+        // Appends the dashes cut from the path instead, with the dash lengths and offset multiplied by the scale. Each
+        // subpath starts the pattern over. A pattern without any length appends the whole path.
+        void AppendDashes(NVGcontext* nvg, const std::vector<float>& pattern, float offset, float scale) const;
+
+    private:
+        enum class CommandType
+        {
+            MoveTo,
+            LineTo,
+            BezierTo,
+            Close,
+        };
+
+        struct Command
+        {
+            CommandType Type;
+            float Points[6];
+        };
+
+        std::vector<Command> m_commands{};
+    };
+}
@@ -0,0 +1,54 @@
+#include "TextCache.h"
+
+#include <functional>
+
+namespace Babylon::Polyfills::Internal
+{
+    size_t TextCache::KeyHash::operator()(const Key& key) const
+    {
+        size_t hash{std::hash<std::string>{}(key.Text)};
+        hash ^= std::hash<int>{}(key.FontId) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        hash ^= std::hash<float>{}(key.FontSize) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+
+    TextCache::TextCache(size_t capacity)
+        : m_capacity{capacity}
+    {
+    }
+
+    const TextCache::Layout* TextCache::Find(int fontId, float fontSize, const std::string& text)
+    {
+        const auto it{m_index.find({fontId, fontSize, text})};
+        if (it == m_index.end())
+        {
+            return nullptr;
+        }
+
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        return &it->second->second;
+    }
+
+    const TextCache::Layout& TextCache::Insert(int fontId, float fontSize, const std::string& text, const Layout& layout)
+    {
+        Key key{fontId, fontSize, text};
+
+        const auto it{m_index.find(key)};
+        if (it != m_index.end())
+        {
+            it->second->second = layout;
+            m_entries.splice(m_entries.begin(), m_entries, it->second);
+            return it->second->second;
+        }
+
+        if (m_entries.size() >= m_capacity)
+        {
+            m_index.erase(m_entries.back().first);
+            m_entries.pop_back();
+        }
+
+        m_entries.emplace_front(key, layout);
+        m_index.emplace(std::move(key), m_entries.begin());
+        return m_entries.front().second;
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+namespace Babylon::Polyfills::Internal
+{
+    // Least recently used cache of text measurements, keyed by font, font size and string.
+    class TextCache final
+    {
+    public:
+        struct Layout
+        {
+            // Bounds of the text drawn at the origin, as xmin, ymin, xmax, ymax, and the horizontal advance.
+            float Bounds[4]{};
+            float Advance{};
+        };
+
+        explicit TextCache(size_t capacity);
+
+        // Returns the cached layout, or nullptr when the text hasn't been measured with this font.
+        const Layout* Find(int fontId, float fontSize, const std::string& text);
+        const Layout& Insert(int fontId, float fontSize, const std::string& text, const Layout& layout);
+
+    private:
+        struct Key
+        {
+            int FontId{};
+            float FontSize{};
+            std::string Text{};
+
+            bool operator==(const Key& other) const
+            {
+                return FontId == other.FontId && FontSize == other.FontSize && Text == other.Text;
+            }
+        };
+
+        struct KeyHash
+        {
+            size_t operator()(const Key& key) const;
+        };
+
+        using Entries = std::list<std::pair<Key, Layout>>;
+
+        const size_t m_capacity;
+        Entries m_entries{};
+        std::unordered_map<Key, Entries::iterator, KeyHash> m_index{};
+    };
+}
@@ -133,6 +133,21 @@ namespace
         float type;
     };
 
+    struct GLNVGbatch
+    {
+        int open;
+        int uniformOffset;
+        int image;
+        uint64_t state;
+        uint32_t stencilFront;
+        uint32_t stencilBack;
+
+        // Indices are relative to baseVertex, so a batch spans at most 64k vertices.
+        int firstIndex;
+        int baseVertex;
+        int endVertex;
+    };
+
     struct GLNVGcontext
     {
         bx::AllocatorI* allocator;
@@ -155,6 +170,29 @@ namespace
         bgfx::TextureHandle texMissing;
 
         bgfx::TransientVertexBuffer tvb;
+        bgfx::TransientIndexBuffer tib;
+        uint16_t* indices;
+        int nindices;
+        int cindices;
+
+        // Growable buffers used instead of the transient ones when a flush doesn't fit in what is left of them. They
+        // are appended to during a frame since bgfx applies all the updates of a frame before rendering it.
+        int dynamic;
+        bgfx::DynamicVertexBufferHandle dvb;
+        bgfx::DynamicIndexBufferHandle dib;
+        int cdvb;
+        int ndvb;
+        int cdib;
+        int ndib;
+        int vertexBase;
+        int indexBase;
+        uint32_t frameNumber;
+        uint32_t dynamicFrameNumber;
+
+        // Draws are merged while they share their uniforms, texture and state.
+        struct GLNVGbatch batch;
+        struct NVGrenderStats stats;
+
         Babylon::Graphics::FrameBuffer* frameBuffer;
         bgfx::Encoder* encoder;
 
@@ -321,7 +359,9 @@ namespace
                         , false
                         , 1
                         , NVG_TEXTURE_RGBA == _type ? bgfx::TextureFormat::RGBA8 : bgfx::TextureFormat::R8
-                        , BGFX_SAMPLER_NONE
+                        , 0
+                        | (_flags & NVG_IMAGE_REPEATX ? BGFX_SAMPLER_NONE : BGFX_SAMPLER_U_CLAMP)
+                        | (_flags & NVG_IMAGE_REPEATY ? BGFX_SAMPLER_NONE : BGFX_SAMPLER_V_CLAMP)
                         );
 
         if (NULL != mem)
@@ -555,20 +595,179 @@ namespace
         gl->view[1] = height;
     }
 
-    static void fan(bgfx::Encoder* encoder, uint32_t _start, uint32_t _count)
+    static void glnvg__submitBatch(struct GLNVGcontext* gl)
     {
-        uint32_t numTris = _count-2;
-        bgfx::TransientIndexBuffer tib;
-        bgfx::allocTransientIndexBuffer(&tib, numTris*3);
-        uint16_t* data = (uint16_t*)tib.data;
-        for (uint32_t ii = 0; ii < numTris; ++ii)
+        struct GLNVGbatch* batch = &gl->batch;
+        int numIndices = gl->nindices - batch->firstIndex;
+        if (numIndices > 0)
+        {
+            nvgRenderSetUniforms(gl, batch->uniformOffset, batch->image);
+
+            gl->encoder->setState(batch->state);
+            gl->encoder->setStencil(batch->stencilFront, batch->stencilBack);
+            if (gl->dynamic)
+            {
+                gl->encoder->setVertexBuffer(0, gl->dvb, gl->vertexBase + batch->baseVertex, batch->endVertex - batch->baseVertex);
+                gl->encoder->setIndexBuffer(gl->dib, gl->indexBase + batch->firstIndex, numIndices);
+            }
+            else
+            {
+                gl->encoder->setVertexBuffer(0, &gl->tvb, batch->baseVertex, batch->endVertex - batch->baseVertex);
+                gl->encoder->setIndexBuffer(&gl->tib, batch->firstIndex, numIndices);
+            }
+            gl->encoder->setTexture(0, gl->s_tex, gl->th);
+            gl->frameBuffer->Submit(*gl->encoder, gl->prog, BGFX_DISCARD_ALL);
+            gl->stats.drawCalls++;
+        }
+
+        batch->firstIndex = gl->nindices;
+        batch->baseVertex = -1;
+        batch->endVertex = -1;
+    }
+
+    static void glnvg__endBatch(struct GLNVGcontext* gl)
+    {
+        if (gl->batch.open)
+        {
+            glnvg__submitBatch(gl);
+            gl->batch.open = 0;
+        }
+    }
+
+    static void glnvg__beginBatch(struct GLNVGcontext* gl, int uniformOffset, int image, uint64_t state, uint32_t stencilFront = BGFX_STENCIL_NONE, uint32_t stencilBack = BGFX_STENCIL_NONE)
+    {
+        struct GLNVGbatch* batch = &gl->batch;
+        if (batch->open)
+        {
+            // The scissor and paint are part of the fragment uniforms.
+            if (batch->image == image
+            &&  batch->state == state
+            &&  batch->stencilFront == stencilFront
+            &&  batch->stencilBack == stencilBack
+            &&  (batch->uniformOffset == uniformOffset
+              || bx::memCmp(nvg__fragUniformPtr(gl, batch->uniformOffset), nvg__fragUniformPtr(gl, uniformOffset), sizeof(struct GLNVGfragUniforms) ) == 0) )
+            {
+                return;
+            }
+
+            glnvg__endBatch(gl);
+        }
+
+        batch->open = 1;
+        batch->uniformOffset = uniformOffset;
+        batch->image = image;
+        batch->state = state;
+        batch->stencilFront = stencilFront;
+        batch->stencilBack = stencilBack;
+        batch->firstIndex = gl->nindices;
+        batch->baseVertex = -1;
+        batch->endVertex = -1;
+    }
+
+    // Vertices a batch can address with 16 bit indices.
+    static const int GLNVG_MAX_BATCH_VERTICES = UINT16_MAX + 1;
+
+    // Adds [offset, offset + count) to the vertices of the batch and returns the index of offset relative to the batch, or -1.
+    // Strips and lists are split to fit, only a fan needs all of its vertices in one batch.
+    static int glnvg__batchVertices(struct GLNVGcontext* gl, int offset, int count, int numIndices)
+    {
+        struct GLNVGbatch* batch = &gl->batch;
+
+        if (count > GLNVG_MAX_BATCH_VERTICES || gl->nindices + numIndices > gl->cindices)
         {
-            data[ii*3+0] = _start;
-            data[ii*3+1] = _start + ii + 1;
-            data[ii*3+2] = _start + ii + 2;
+            BX_WARN(false, "Fill skipped, its path has more vertices than 16 bit indices can address");
+            return -1;
         }
 
-        encoder->setIndexBuffer(&tib);
+        if (batch->baseVertex != -1 && offset + count - batch->baseVertex > GLNVG_MAX_BATCH_VERTICES)
+        {
+            glnvg__submitBatch(gl);
+        }
+
+        if (batch->baseVertex == -1)
+        {
+            batch->baseVertex = offset;
+        }
+
+        batch->endVertex = bx::max(batch->endVertex, offset + count);
+        return offset - batch->baseVertex;
+    }
+
+    static void glnvg__batchFan(struct GLNVGcontext* gl, int offset, int count)
+    {
+        if (count < 3)
+        {
+            return;
+        }
+
+        int numTris = count - 2;
+        int start = glnvg__batchVertices(gl, offset, count, numTris * 3);
+        if (start < 0)
+        {
+            return;
+        }
+
+        uint16_t* data = gl->indices + gl->nindices;
+        for (int ii = 0; ii < numTris; ++ii)
+        {
+            data[ii*3+0] = uint16_t(start);
+            data[ii*3+1] = uint16_t(start + ii + 1);
+            data[ii*3+2] = uint16_t(start + ii + 2);
+        }
+        gl->nindices += numTris * 3;
+    }
+
+    static void glnvg__batchStrip(struct GLNVGcontext* gl, int offset, int count)
+    {
+        // Long strips, such as long strokes, continue in the next batch from the last two vertices of the previous one.
+        while (count >= 3)
+        {
+            int numVerts = bx::min(count, GLNVG_MAX_BATCH_VERTICES);
+            int numTris = numVerts - 2;
+            int start = glnvg__batchVertices(gl, offset, numVerts, numTris * 3);
+            if (start < 0)
+            {
+                return;
+            }
+
+            // Nothing is culled, so the alternating winding of the strip doesn't need to be preserved.
+            uint16_t* data = gl->indices + gl->nindices;
+            for (int ii = 0; ii < numTris; ++ii)
+            {
+                data[ii*3+0] = uint16_t(start + ii);
+                data[ii*3+1] = uint16_t(start + ii + 1);
+                data[ii*3+2] = uint16_t(start + ii + 2);
+            }
+            gl->nindices += numTris * 3;
+
+            offset += numTris;
+            count -= numTris;
+        }
+    }
+
+    static void glnvg__batchList(struct GLNVGcontext* gl, int offset, int count)
+    {
+        // Long lists, such as the glyphs of long texts, are split on triangle boundaries.
+        count -= count % 3;
+        while (count >= 3)
+        {
+            int numVerts = bx::min(count, GLNVG_MAX_BATCH_VERTICES - GLNVG_MAX_BATCH_VERTICES % 3);
+            int start = glnvg__batchVertices(gl, offset, numVerts, numVerts);
+            if (start < 0)
+            {
+                return;
+            }
+
+            uint16_t* data = gl->indices + gl->nindices;
+            for (int ii = 0; ii < numVerts; ++ii)
+            {
+                data[ii] = uint16_t(start + ii);
+            }
+            gl->nindices += numVerts;
+
+            offset += numVerts;
+            count -= numVerts;
+        }
     }
 
     static void glnvg__fill(struct GLNVGcontext* gl, struct GLNVGcall* call)
@@ -576,70 +775,60 @@ namespace
         struct GLNVGpath* paths = &gl->paths[call->pathOffset];
         int i, npaths = call->pathCount;
 
-        // set bindpoint for solid loc
-        nvgRenderSetUniforms(gl, call->uniformOffset, 0);
+        // Winding of all the paths into the stencil, with the simple shader.
+        glnvg__beginBatch(gl, call->uniformOffset, 0, 0
+            , BGFX_STENCIL_TEST_ALWAYS
+            | BGFX_STENCIL_FUNC_RMASK(0xff)
+            | BGFX_STENCIL_OP_FAIL_S_KEEP
+            | BGFX_STENCIL_OP_FAIL_Z_KEEP
+            | BGFX_STENCIL_OP_PASS_Z_INCR
+            , BGFX_STENCIL_TEST_ALWAYS
+            | BGFX_STENCIL_FUNC_RMASK(0xff)
+            | BGFX_STENCIL_OP_FAIL_S_KEEP
+            | BGFX_STENCIL_OP_FAIL_Z_KEEP
+            | BGFX_STENCIL_OP_PASS_Z_DECR
+            );
 
         for (i = 0; i < npaths; i++)
         {
-            if (2 < paths[i].fillCount)
-            {
-                gl->encoder->setState(0);
-                gl->encoder->setStencil(0
-                    | BGFX_STENCIL_TEST_ALWAYS
-                    | BGFX_STENCIL_FUNC_RMASK(0xff)
-                    | BGFX_STENCIL_OP_FAIL_S_KEEP
-                    | BGFX_STENCIL_OP_FAIL_Z_KEEP
-                    | BGFX_STENCIL_OP_PASS_Z_INCR
-                    , 0
-                    | BGFX_STENCIL_TEST_ALWAYS
-                    | BGFX_STENCIL_FUNC_RMASK(0xff)
-                    | BGFX_STENCIL_OP_FAIL_S_KEEP
-                    | BGFX_STENCIL_OP_FAIL_Z_KEEP
-                    | BGFX_STENCIL_OP_PASS_Z_DECR
-                    );
-                gl->encoder->setVertexBuffer(0, &gl->tvb);
-                gl->encoder->setTexture(0, gl->s_tex, gl->th);
-                fan(gl->encoder, paths[i].fillOffset, paths[i].fillCount);
-                gl->frameBuffer->Submit(*gl->encoder, gl->prog, BGFX_DISCARD_ALL);
-            }
+            glnvg__batchFan(gl, paths[i].fillOffset, paths[i].fillCount);
         }
 
-        // Draw aliased off-pixels
-        nvgRenderSetUniforms(gl, call->uniformOffset + gl->fragSize, call->image);
-
         if (gl->edgeAntiAlias)
         {
             // Draw fringes
+            glnvg__beginBatch(gl, call->uniformOffset + gl->fragSize, call->image, gl->state
+                , BGFX_STENCIL_TEST_EQUAL
+                | BGFX_STENCIL_FUNC_RMASK(0xff)
+                | BGFX_STENCIL_OP_FAIL_S_KEEP
+                | BGFX_STENCIL_OP_FAIL_Z_KEEP
+                | BGFX_STENCIL_OP_PASS_Z_KEEP
+                );
+
             for (i = 0; i < npaths; i++)
             {
-                gl->encoder->setState(gl->state
-                    | BGFX_STATE_PT_TRISTRIP
-                    );
-                gl->encoder->setStencil(0
-                    | BGFX_STENCIL_TEST_EQUAL
-                    | BGFX_STENCIL_FUNC_RMASK(0xff)
-                    | BGFX_STENCIL_OP_FAIL_S_KEEP
-                    | BGFX_STENCIL_OP_FAIL_Z_KEEP
-                    | BGFX_STENCIL_OP_PASS_Z_KEEP
-                    );
-                gl->encoder->setVertexBuffer(0, &gl->tvb, paths[i].strokeOffset, paths[i].strokeCount);
-                gl->encoder->setTexture(0, gl->s_tex, gl->th);
-                gl->frameBuffer->Submit(*gl->encoder, gl->prog, BGFX_DISCARD_ALL);
+                glnvg__batchStrip(gl, paths[i].strokeOffset, paths[i].strokeCount);
             }
         }
 
         // Draw fill
-        gl->encoder->setState(gl->state);
-        gl->encoder->setVertexBuffer(0, &gl->tvb, call->vertexOffset, call->vertexCount);
-        gl->encoder->setTexture(0, gl->s_tex, gl->th);
-        gl->encoder->setStencil(0
-                | BGFX_STENCIL_TEST_NOTEQUAL
-                | BGFX_STENCIL_FUNC_RMASK(0xff)
-                | BGFX_STENCIL_OP_FAIL_S_ZERO
-                | BGFX_STENCIL_OP_FAIL_Z_ZERO
-                | BGFX_STENCIL_OP_PASS_Z_ZERO
-                );
-        gl->frameBuffer->Submit(*gl->encoder, gl->prog, BGFX_DISCARD_ALL);
+        glnvg__beginBatch(gl, call->uniformOffset + gl->fragSize, call->image, gl->state
+            , BGFX_STENCIL_TEST_NOTEQUAL
+            | BGFX_STENCIL_FUNC_RMASK(0xff)
+            | BGFX_STENCIL_OP_FAIL_S_ZERO
+            | BGFX_STENCIL_OP_FAIL_Z_ZERO
+            | BGFX_STENCIL_OP_PASS_Z_ZERO
+            );
+        glnvg__batchList(gl, call->vertexOffset, call->vertexCount);
+
+        // The stencil is only valid for this fill.
+        glnvg__endBatch(gl);
+
+        gl->stats.unbatchedDrawCalls += 1 + (gl->edgeAntiAlias ? npaths : 0);
+        for (i = 0; i < npaths; i++)
+        {
+            gl->stats.unbatchedDrawCalls += 2 < paths[i].fillCount ? 1 : 0;
+        }
     }
 
     static void glnvg__convexFill(struct GLNVGcontext* gl, struct GLNVGcall* call)
@@ -647,16 +836,12 @@ namespace
         struct GLNVGpath* paths = &gl->paths[call->pathOffset];
         int i, npaths = call->pathCount;
 
-        nvgRenderSetUniforms(gl, call->uniformOffset, call->image);
+        glnvg__beginBatch(gl, call->uniformOffset, call->image, gl->state);
 
         for (i = 0; i < npaths; i++)
         {
-            if (paths[i].fillCount == 0) continue;
-            gl->encoder->setState(gl->state);
-            gl->encoder->setVertexBuffer(0, &gl->tvb);
-            gl->encoder->setTexture(0, gl->s_tex, gl->th);
-            fan(gl->encoder, paths[i].fillOffset, paths[i].fillCount);
-            gl->frameBuffer->Submit(*gl->encoder, gl->prog, BGFX_DISCARD_ALL);
+            glnvg__batchFan(gl, paths[i].fillOffset, paths[i].fillCount);
+            gl->stats.unbatchedDrawCalls += paths[i].fillCount == 0 ? 0 : 1;
         }
 
         if (gl->edgeAntiAlias)
@@ -664,13 +849,9 @@ namespace
             // Draw fringes
             for (i = 0; i < npaths; i++)
             {
-                gl->encoder->setState(gl->state
-                    | BGFX_STATE_PT_TRISTRIP
-                    );
-                gl->encoder->setVertexBuffer(0, &gl->tvb, paths[i].strokeOffset, paths[i].strokeCount);
-                gl->encoder->setTexture(0, gl->s_tex, gl->th);
-                gl->frameBuffer->Submit(*gl->encoder, gl->prog, BGFX_DISCARD_ALL);
+                glnvg__batchStrip(gl, paths[i].strokeOffset, paths[i].strokeCount);
             }
+            gl->stats.unbatchedDrawCalls += npaths;
         }
     }
 
@@ -679,31 +860,45 @@ namespace
         struct GLNVGpath* paths = &gl->paths[call->pathOffset];
         int npaths = call->pathCount, i;
 
-        nvgRenderSetUniforms(gl, call->uniformOffset, call->image);
+        glnvg__beginBatch(gl, call->uniformOffset, call->image, gl->state);
 
         // Draw Strokes
         for (i = 0; i < npaths; i++)
         {
-            gl->encoder->setState(gl->state
-                | BGFX_STATE_PT_TRISTRIP
-                );
-            gl->encoder->setVertexBuffer(0, &gl->tvb, paths[i].strokeOffset, paths[i].strokeCount);
-            gl->encoder->setTexture(0, gl->s_tex, gl->th);
-            gl->frameBuffer->Submit(*gl->encoder, gl->prog, BGFX_DISCARD_ALL);
+            glnvg__batchStrip(gl, paths[i].strokeOffset, paths[i].strokeCount);
         }
+        gl->stats.unbatchedDrawCalls += npaths;
     }
 
     static void glnvg__triangles(struct GLNVGcontext* gl, struct GLNVGcall* call)
     {
         if (3 <= call->vertexCount)
         {
-            nvgRenderSetUniforms(gl, call->uniformOffset, call->image);
+            glnvg__beginBatch(gl, call->uniformOffset, call->image, gl->state);
+            glnvg__batchList(gl, call->vertexOffset, call->vertexCount);
+            gl->stats.unbatchedDrawCalls++;
+        }
+    }
 
-            gl->encoder->setState(gl->state);
-            gl->encoder->setVertexBuffer(0, &gl->tvb, call->vertexOffset, call->vertexCount);
-            gl->encoder->setTexture(0, gl->s_tex, gl->th);
-            gl->frameBuffer->Submit(*gl->encoder, gl->prog, BGFX_DISCARD_ALL);
+    // Upper bound of the indices needed to draw the calls as indexed triangle lists.
+    static int glnvg__indexCount(struct GLNVGcontext* gl)
+    {
+        int count = 0;
+        for (int ii = 0; ii < gl->ncalls; ++ii)
+        {
+            const struct GLNVGcall* call = &gl->calls[ii];
+            const struct GLNVGpath* paths = &gl->paths[call->pathOffset];
+            for (int jj = 0; jj < call->pathCount; ++jj)
+            {
+                count += bx::max(paths[jj].fillCount - 2, 0) * 3;
+                count += bx::max(paths[jj].strokeCount - 2, 0) * 3;
+            }
+            if (call->type == GLNVG_FILL || call->type == GLNVG_TRIANGLES)
+            {
+                count += call->vertexCount;
+            }
         }
+        return count;
     }
 
     static const uint64_t s_blend[] =
@@ -745,6 +940,44 @@ namespace
         return blend;
     }
 
+    static void glnvg__reserveDynamic(struct GLNVGcontext* gl, int nverts, int nindices)
+    {
+        if (gl->dynamicFrameNumber != gl->frameNumber)
+        {
+            gl->ndvb = 0;
+            gl->ndib = 0;
+            gl->dynamicFrameNumber = gl->frameNumber;
+        }
+
+        // Draws already submitted this frame keep the old buffers, which bgfx destroys once the frame is rendered.
+        if (gl->ndvb + nverts > gl->cdvb)
+        {
+            if (bgfx::isValid(gl->dvb) )
+            {
+                bgfx::destroy(gl->dvb);
+            }
+            gl->cdvb = bx::max(gl->cdvb * 2, nverts);
+            gl->dvb = bgfx::createDynamicVertexBuffer(gl->cdvb, s_nvgLayout);
+            gl->ndvb = 0;
+        }
+
+        if (gl->ndib + nindices > gl->cdib)
+        {
+            if (bgfx::isValid(gl->dib) )
+            {
+                bgfx::destroy(gl->dib);
+            }
+            gl->cdib = bx::max(gl->cdib * 2, nindices);
+            gl->dib = bgfx::createDynamicIndexBuffer(gl->cdib);
+            gl->ndib = 0;
+        }
+
+        gl->vertexBase = gl->ndvb;
+        gl->indexBase = gl->ndib;
+        gl->ndvb += nverts;
+        gl->ndib += nindices;
+    }
+
     static void nvgRenderFlush(void* _userPtr)
     {
         struct GLNVGcontext* gl = (struct GLNVGcontext*)_userPtr;
@@ -761,17 +994,40 @@ namespace
 
         if (gl->ncalls > 0)
         {
-            bgfx::allocTransientVertexBuffer(&gl->tvb, gl->nverts, s_nvgLayout);
+            // All the draws of the flush index into one index buffer.
+            int numIndices = glnvg__indexCount(gl);
+            const bgfx::Memory* indexMemory = NULL;
 
-            int allocated = gl->tvb.size/gl->tvb.stride;
+            gl->dynamic = bgfx::getAvailTransientVertexBuffer(gl->nverts, s_nvgLayout) < uint32_t(gl->nverts)
+                       || bgfx::getAvailTransientIndexBuffer(numIndices) < uint32_t(numIndices);
+            gl->indices = NULL;
 
-            if (allocated < gl->nverts)
+            if (gl->dynamic)
+            {
+                glnvg__reserveDynamic(gl, gl->nverts, numIndices);
+                bgfx::update(gl->dvb, gl->vertexBase, bgfx::copy(gl->verts, gl->nverts * sizeof(struct NVGvertex) ) );
+                if (numIndices > 0)
+                {
+                    indexMemory = bgfx::alloc(numIndices * sizeof(uint16_t) );
+                    gl->indices = (uint16_t*)indexMemory->data;
+                }
+                gl->stats.overflows++;
+            }
+            else
             {
-                gl->nverts = allocated;
-                BX_WARN(true, "Vertex number truncated due to transient vertex buffer overflow");
+                bgfx::allocTransientVertexBuffer(&gl->tvb, gl->nverts, s_nvgLayout);
+                bx::memCopy(gl->tvb.data, gl->verts, gl->nverts * sizeof(struct NVGvertex) );
+                if (numIndices > 0)
+                {
+                    bgfx::allocTransientIndexBuffer(&gl->tib, numIndices);
+                    gl->indices = (uint16_t*)gl->tib.data;
+                }
             }
 
-            bx::memCopy(gl->tvb.data, gl->verts, gl->nverts * sizeof(struct NVGvertex) );
+            gl->nindices = 0;
+            gl->cindices = numIndices;
+            gl->batch.open = 0;
+            gl->stats.vertices += gl->nverts;
 
             gl->encoder->setUniform(gl->u_viewSize, gl->view);
 
@@ -802,6 +1058,13 @@ namespace
                     break;
                 }
             }
+
+            glnvg__endBatch(gl);
+
+            if (indexMemory != NULL)
+            {
+                bgfx::update(gl->dib, gl->indexBase, indexMemory);
+            }
         }
 
         // Reset calls
@@ -1061,6 +1324,16 @@ namespace
         }
         bgfx::destroy(gl->texMissing);
 
+        if (bgfx::isValid(gl->dvb) )
+        {
+            bgfx::destroy(gl->dvb);
+        }
+
+        if (bgfx::isValid(gl->dib) )
+        {
+            bgfx::destroy(gl->dib);
+        }
+
         bgfx::destroy(gl->u_scissorMat);
         bgfx::destroy(gl->u_paintMat);
         bgfx::destroy(gl->u_innerCol);
@@ -1129,6 +1402,8 @@ NVGcontext* nvgCreate(int32_t _edgeaa, bx::AllocatorI* _allocator)
 
     gl->allocator     = _allocator;
     gl->edgeAntiAlias = _edgeaa;
+    gl->dvb           = BGFX_INVALID_HANDLE;
+    gl->dib           = BGFX_INVALID_HANDLE;
 
     ctx = nvgCreateInternal(&params);
     if (ctx == NULL) goto error;
@@ -1145,11 +1420,19 @@ error:
     return NULL;
 }
 
-void nvgSetFrameBufferAndEncoder(NVGcontext* _ctx, Babylon::Graphics::FrameBuffer& frameBuffer, bgfx::Encoder* encoder)
+void nvgSetFrameBufferAndEncoder(NVGcontext* _ctx, Babylon::Graphics::FrameBuffer& frameBuffer, bgfx::Encoder* encoder, uint32_t frameNumber)
 {
     struct GLNVGcontext* gl = (GLNVGcontext*)nvgInternalParams(_ctx)->userPtr;
     gl->encoder = encoder;
     gl->frameBuffer = &frameBuffer;
+    gl->frameNumber = frameNumber;
+}
+
+void nvgGetRenderStats(NVGcontext* _ctx, NVGrenderStats* _stats)
+{
+    struct GLNVGcontext* gl = (GLNVGcontext*)nvgInternalParams(_ctx)->userPtr;
+    *_stats = gl->stats;
+    bx::memSet(&gl->stats, 0, sizeof(gl->stats) );
 }
 
 NVGcontext* nvgCreate(int32_t _edgeaa) {
@@ -1161,6 +1444,24 @@ void nvgDelete(NVGcontext* _ctx)
     nvgDeleteInternal(_ctx);
 }
 
+int nvgCreateImageFromHandle(NVGcontext* _ctx, bgfx::TextureHandle _handle, int _width, int _height, int _flags)
+{
+    GLNVGcontext* gl = (GLNVGcontext*)nvgInternalParams(_ctx)->userPtr;
+    GLNVGtexture* tex = glnvg__allocTexture(gl);
+    if (tex == NULL)
+    {
+        return 0;
+    }
+
+    tex->id     = _handle;
+    tex->width  = _width;
+    tex->height = _height;
+    tex->type   = NVG_TEXTURE_RGBA;
+    tex->flags  = _flags | NVG_IMAGE_NODELETE;
+
+    return bgfx::isValid(tex->id) ? tex->id.idx : 0;
+}
+
 bgfx::TextureHandle nvglImageHandle(NVGcontext* _ctx, int32_t _image)
 {
     GLNVGcontext* gl = (GLNVGcontext*)nvgInternalParams(_ctx)->userPtr;
@@ -15,13 +15,30 @@ namespace bx
 
 struct NVGcontext;
 
+struct NVGrenderStats
+{
+    // Draw calls needed to submit each path on its own, and the draw calls submitted once paths are batched.
+    int unbatchedDrawCalls;
+    int drawCalls;
+
+    // Vertices flushed, and flushes that didn't fit in the transient buffers left in the frame.
+    int vertices;
+    int overflows;
+};
+
 ///
 NVGcontext* nvgCreate(int32_t _edgeaa, bx::AllocatorI* _allocator);
 
 ///
 NVGcontext* nvgCreate(int32_t _edgeaa);
 
-void nvgSetFrameBufferAndEncoder(NVGcontext* _ctx, Babylon::Graphics::FrameBuffer& frameBuffer, bgfx::Encoder* encoder);
+void nvgSetFrameBufferAndEncoder(NVGcontext* _ctx, Babylon::Graphics::FrameBuffer& frameBuffer, bgfx::Encoder* encoder, uint32_t frameNumber);
+
+/// Creates an RGBA image that draws an existing texture, which stays owned by the caller.
+int nvgCreateImageFromHandle(NVGcontext* _ctx, bgfx::TextureHandle _handle, int _width, int _height, int _flags);
+
+/// Returns the stats accumulated by the flushes since the last call.
+void nvgGetRenderStats(NVGcontext* _ctx, NVGrenderStats* _stats);
 
 ///
 void nvgDelete(NVGcontext* _ctx);
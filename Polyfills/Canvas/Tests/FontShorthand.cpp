@@ -0,0 +1,68 @@
+#include "gtest/gtest.h"
+#include "../Source/FontShorthand.h"
+
+#include <chrono>
+#include <iostream>
+#include <regex>
+#include <string>
+#include <vector>
+
+using Babylon::Polyfills::Internal::FontShorthand;
+using Babylon::Polyfills::Internal::ParseFontShorthand;
+
+namespace
+{
+    // Font strings as built by Babylon GUI controls from their style, weight, size and family.
+    const std::vector<std::string> GUI_FONTS{
+        " 18px Arial",
+        " bold 24px Arial",
+        "italic  14px Segoe UI",
+        "italic bold 36px 'Helvetica Neue', sans-serif",
+        "normal 400 12px/1.5 \"Open Sans\", Arial, sans-serif",
+    };
+}
+
+TEST(CanvasFontShorthand, Parse)
+{
+    FontShorthand font{};
+    ASSERT_TRUE(ParseFontShorthand(GUI_FONTS[3], font));
+    EXPECT_EQ(font.Size, 36.f);
+    ASSERT_EQ(font.Families.size(), 2u);
+    EXPECT_EQ(font.Families[0], "Helvetica Neue");
+    EXPECT_EQ(font.Families[1], "sans-serif");
+
+    for (const auto& guiFont : GUI_FONTS)
+    {
+        EXPECT_TRUE(ParseFontShorthand(guiFont, font)) << guiFont;
+    }
+}
+
+// Compares the parser with the regular expression the canvas used before. Run with --gtest_also_run_disabled_tests.
+TEST(CanvasFontShorthand, DISABLED_Benchmark)
+{
+    constexpr size_t iterations{100000};
+
+    FontShorthand font{};
+    size_t parsed{0};
+    const auto parserStart{std::chrono::high_resolution_clock::now()};
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        parsed += ParseFontShorthand(GUI_FONTS[i % GUI_FONTS.size()], font) ? 1 : 0;
+    }
+    const auto parserDuration{std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - parserStart)};
+    EXPECT_EQ(parsed, iterations);
+
+    // Only understands single word families.
+    const std::regex fontStyleRegex("([[a-zA-Z]+\\s+)*((\\d+)px\\s+)?(\\w+)");
+    std::smatch fontStyleMatch{};
+    size_t matched{0};
+    const auto regexStart{std::chrono::high_resolution_clock::now()};
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        matched += std::regex_match(GUI_FONTS[i % GUI_FONTS.size()], fontStyleMatch, fontStyleRegex) ? 1 : 0;
+    }
+    const auto regexDuration{std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - regexStart)};
+
+    std::cout << "ParseFontShorthand: " << parserDuration.count() << " us, std::regex: " << regexDuration.count() << " us (" << matched << " of " << iterations << " matched)" << std::endl;
+    std::cout.flush();
+}